@@ -0,0 +1,53 @@
+/*! \file arena.hpp
+	\brief bump allocator for search tree nodes
+	 nodes are 32-bit ids into fixed-size slabs, a whole tree is released
+	 by reset() and the slabs are kept for the next one
+	\course Theory of Computer Game (TCG)
+*/
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <cstdint>
+#include <cassert>
+#include <vector>
+#include <memory>
+
+template<class T, int SLAB_BITS = 16> struct _arena {
+	static constexpr uint32_t SLAB_SZ = uint32_t(1)<<SLAB_BITS;
+	static constexpr uint32_t NIL = UINT32_MAX; // no node
+	static constexpr uint64_t MAX_SLABS = (uint64_t(1)<<32)>>SLAB_BITS;
+
+	std::vector<std::unique_ptr<T[]>> slabs;
+	uint32_t used = 0; // ids [0, used) are handed out
+
+	#ifdef tree_parallel
+	// the slab table never moves, so nodes can be read while another
+	// thread allocates (the allocating threads still need a lock)
+	_arena () { slabs.reserve(MAX_SLABS); }
+	#endif
+
+	// ids of n consecutive nodes, never split over two slabs
+	uint32_t alloc ( uint32_t n = 1 ) {
+		assert(n <= SLAB_SZ);
+		if ( (used&(SLAB_SZ-1))+n > SLAB_SZ ) {
+			used = (used|(SLAB_SZ-1))+1;
+		}
+		uint32_t id = used;
+		used += n;
+		while ( (used+SLAB_SZ-1)>>SLAB_BITS > slabs.size() ) {
+			slabs.emplace_back(new T[SLAB_SZ]);
+		}
+		return (id);
+	}
+	T &operator [] ( uint32_t const &id ) noexcept {
+		return (slabs[id>>SLAB_BITS][id&(SLAB_SZ-1)]);
+	}
+	T const &operator [] ( uint32_t const &id ) const noexcept {
+		return (slabs[id>>SLAB_BITS][id&(SLAB_SZ-1)]);
+	}
+	uint32_t size () const noexcept { return (used); }
+	// drops every node at once, they are rebuilt by whoever allocates them next
+	void reset () noexcept { used = 0; }
+};
+
+#endif
@@ -23,8 +23,7 @@
 #include "einstein.hpp"
 
 char start;
-char init[2][NUM_CUBE+1] = {};
-BOARD_GUI *b, tmp_b;
+std::string init[2];
 bool myturn;
 inline void flip_bit ( bool &_ ) { _ = !_; }
 char num, dir;
@@ -45,7 +44,9 @@ using PII = std::pair<int, int>;
 #define DRAW 50
 #define WIN 100
 
-double eval ( BOARD_GUI *eval_b ) { // evaluating a board
+template<class BOARD_T> double eval ( BOARD_T *eval_b ) { // evaluating a board
+	const int NUM_CUBE = BOARD_T::NUM_CUBE;
+	const int BOARD_SZ = BOARD_T::BOARD_SZ;
 	if ( eval_b->winner()!=Color::OTHER ) {
 		if ( eval_b->winner() == eval_b->turn() ) { // lose
 			return (-WIN);
@@ -85,6 +86,98 @@ double eval ( BOARD_GUI *eval_b ) { // evaluating a board
 }
 #endif
 
+double timer ( bool reset = false ) {
+	static decltype(std::chrono::steady_clock::now()) tick, tock;
+	if ( reset ) {
+		tick = std::chrono::steady_clock::now();
+		return (0);
+	}
+	tock = std::chrono::steady_clock::now();
+	return (std::chrono::duration_cast<std::chrono::duration<double>>(tock-tick).count());
+}
+
+/* play one game on a SZ x SZ board */
+template<int SZ> void play () {
+	/* game start s*/
+	_board_gui<SZ> *b = new _board_gui<SZ>(init[0], init[1]);
+	b->no_hl = 1;
+
+	for ( myturn=(start=='f'); b->winner()==Color::OTHER; flip_bit(myturn) ) {
+		if ( myturn ) {
+#ifdef GREEDY
+			// flog << "origin\n";
+			// flog << *(b);
+			auto ml = b->move_list();
+			PII m;
+			double val = -10000;
+			// flog << "ml size: " << ml.size() << std::endl;
+			if(ml.size() <= 1){
+				flog << "only one move: " << ml[0].first << " " << ml[0].second << std::endl;
+			}
+			for ( auto &move: ml ) {
+				b->apply_move(move);
+				double tmp = eval(b);
+				// flog << *(b);
+				// flog << "val: " << tmp << std::endl;
+				if ( tmp > val ) {
+					m = move;
+					val = tmp;
+				}
+				b->undo_move();
+			}
+#endif
+#ifdef CONSERVATIVE
+			auto ml = b->move_list();
+			PII m = PII(-1, -1);
+			for ( auto &move: ml ) {
+				if ( b->yummy(move) == 1 ) {
+					m = move;
+					break;
+				}
+			}
+			if ( m.first == -1 ) {
+				for ( auto &move: ml ) {
+					if ( move.second<2 and b->yummy(move) != -1 ) {
+						m = move;
+						break;
+					}
+				}
+			}
+			if ( m.first == -1 ) {
+				m = ml[rand()%ml.size()];
+			}
+#endif
+#ifdef RANDOM
+			auto ml = b->move_list();
+			auto m = ml.at(rand()%ml.size());
+			b->printPos();			
+#endif		
+			flog << "myTurn: " << myturn << b->send_move(m) << std::endl;
+			b->do_move(m);
+			std::cout << b->send_move(m) << std::flush;
+		}
+		else {
+			num = getchar()-'0';
+			dir = getchar()-'0';
+			flog << "oppoTurn: " << myturn << (int)num << (int)dir << std::endl;
+			if ( num == 16 ) {
+				b->undo_move();
+				b->undo_move();
+				flip_bit(myturn);
+			}
+			else {
+				b->do_move(num, dir);
+			}
+		}
+	}
+	flog << "winner: " << b->winner() << std::endl;
+	flog << "history:";
+	for ( auto const &m: b->history ) { flog << " " << m; }
+	flog << std::endl;
+	/* game end */
+	delete b;
+}
+
 int main () 
 {
 #ifdef GREEDY
@@ -97,105 +190,19 @@ int main ()
 	logger(".log.random");
 #endif
 
-	auto timer = [] ( bool reset = false ) -> double {
-		static decltype(std::chrono::steady_clock::now()) tick, tock;
-		if ( reset ) {
-			tick = std::chrono::steady_clock::now();
-			return (0);
-		}
-		tock = std::chrono::steady_clock::now();
-		return (std::chrono::duration_cast<std::chrono::duration<double>>(tock-tick).count());
-	};
-
 	srand(time(NULL));
 
 	do {
 		/* get initial positions */
-		for ( int i=0; i<2; ++i ) { for ( int j=0; j<NUM_CUBE; ++j ) {
-				init[i][j] = getchar();
-		}}
-		init[0][NUM_CUBE] = init[1][NUM_CUBE] = '\0';
-		start = getchar();
+		int sz = read_init_position(init[0], init[1], start);
 
 		flog << init[0] << " " << init[1] << std::endl;
 		flog << start << std::endl;
 
-		/* game start s*/
-		b = new BOARD_GUI(init[0], init[1]);
-		b->no_hl = 1;
-
-		for ( myturn=(start=='f'); b->winner()==Color::OTHER; flip_bit(myturn) ) {
-			if ( myturn ) {
-#ifdef GREEDY
-				// flog << "origin\n";
-				// flog << *(b);
-				auto ml = b->move_list();
-				PII m;
-				double val = -10000;
-				// flog << "ml size: " << ml.size() << std::endl;
-				if(ml.size() <= 1){
-					flog << "only one move: " << ml[0].first << " " << ml[0].second << std::endl;
-				}
-				for ( auto &move: ml ) {
-					b->do_move(move);
-					double tmp = eval(b);
-					// flog << *(b);
-					// flog << "val: " << tmp << std::endl;
-					if ( tmp > val ) {
-						m = move;
-						val = tmp;
-					}
-					b->undo_move();
-				}
-#endif
-#ifdef CONSERVATIVE
-				auto ml = b->move_list();
-				PII m = PII(-1, -1);
-				for ( auto &move: ml ) {
-					if ( b->yummy(move) == 1 ) {
-						m = move;
-						break;
-					}
-				}
-				if ( m.first == -1 ) {
-					for ( auto &move: ml ) {
-						if ( move.second<2 and b->yummy(move) != -1 ) {
-							m = move;
-							break;
-						}
-					}
-				}
-				if ( m.first == -1 ) {
-					m = ml[rand()%ml.size()];
-				}
-#endif
-#ifdef RANDOM
-				auto ml = b->move_list();
-				auto m = ml.at(rand()%ml.size());
-				b->printPos();			
-#endif		
-				flog << "myTurn: " << myturn << b->send_move(m) << std::endl;
-				b->do_move(m);
-				std::cout << b->send_move(m) << std::flush;
-			}
-			else {
-				num = getchar()-'0';
-				dir = getchar()-'0';
-				flog << "oppoTurn: " << myturn << (int)num << (int)dir << std::endl;
-				if ( num == 16 ) {
-					b->undo_move();
-					b->undo_move();
-					flip_bit(myturn);
-				}
-				else {
-					b->do_move(num, dir);
-				}
-			}
-		}
-		flog << "winner: " << b->winner() << std::endl;
-		/* game end */
-		delete b;
+		if ( sz == 7 ) { play<7>(); }
+		else if ( sz == 6 ) { play<6>(); }
+		else { break; }
 	} while ( getchar()=='y' ); 
 
 	return (0);
-}
\ No newline at end of file
+}
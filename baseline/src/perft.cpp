@@ -0,0 +1,112 @@
+/*! \file perft.cpp
+	\brief move generation check and benchmark, counts the leaves of the game tree
+	 ./perft, runs the known counts below on 6x6 and 7x7
+	 ./perft depth red blue, counts one initial layout, same format as
+	  give_init_position() (6 digits per side on 6x6, 10 on 7x7)
+	 a finished game before depth is a dead end (0 leaves), a pass is a move
+	\course Theory of Computer Game (TCG)
+*/
+
+#include <cstdlib>
+#include <cstring>
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <chrono>
+
+#include "einstein.hpp"
+
+std::fstream flog;
+
+using LL = long long;
+
+// counted with the find()-based referee board from before the bitboards
+struct _perft_case {
+	char const *red, *blue;
+	int depth;
+	LL nodes;
+};
+_perft_case const KNOWN[] = {
+	{"013245", "542310", 1, 18},
+	{"013245", "542310", 2, 324},
+	{"013245", "542310", 3, 5454},
+	{"013245", "542310", 4, 91800},
+	{"013245", "542310", 5, 1469028},
+	{"013245", "542310", 6, 23487390},
+	{"342150", "150324", 7, 361690889},
+	{"0136247589", "9857426310", 1, 15},
+	{"0136247589", "9857426310", 2, 225},
+	{"0136247589", "9857426310", 3, 3240},
+	{"0136247589", "9857426310", 4, 46656},
+	{"0136247589", "9857426310", 5, 631800},
+	{"0136247589", "9857426310", 6, 8555625},
+	{"0136247589", "9857426310", 7, 110810655},
+	{"4071289563", "8149026735", 6, 8679771},
+	{"4071289563", "8149026735", 7, 114278742},
+};
+
+template<int SZ> LL perft ( _position<SZ> &p, int depth ) noexcept {
+	typename _position<SZ>::MOVE_BUFFER ml;
+	p.generate_moves(ml);
+	if ( depth == 1 ) { return (ml.size()); }
+	LL nodes = 0;
+	for ( auto &m: ml ) {
+		MOVE undo = p.apply_move(m);
+		nodes += perft(p, depth-1);
+		p.undo_move(undo);
+	}
+	return (nodes);
+}
+
+// prints one line, returns the leaf count
+template<int SZ> LL run ( std::string const &red, std::string const &blue, int depth ) {
+	_position<SZ> p = _board<SZ>(red, blue);
+	auto tick = std::chrono::steady_clock::now();
+	LL nodes = (depth==0)? 1: perft(p, depth);
+	auto tock = std::chrono::steady_clock::now();
+	double sec = std::chrono::duration_cast<std::chrono::duration<double>>(tock-tick).count();
+	printf("%dx%d %s %s depth %d: %12lld nodes %8.3f s %8.2f Mnps", SZ, SZ,
+		red.c_str(), blue.c_str(), depth, nodes, sec, (sec>0)? nodes/sec/1e6: 0.0);
+	return (nodes);
+}
+
+LL run ( std::string const &red, std::string const &blue, int depth ) {
+	if ( red.size() != blue.size() ) {
+		throw std::runtime_error("perft: red and blue differ in length\n");
+	}
+	if ( red.size() == _board_traits<7>::NUM_CUBE ) { return (run<7>(red, blue, depth)); }
+	if ( red.size() == _board_traits<6>::NUM_CUBE ) { return (run<6>(red, blue, depth)); }
+	throw std::runtime_error("perft: unknown board size\n");
+}
+
+int main ( int argc, char **argv )
+{
+	if ( argc == 4 ) {
+		run(argv[2], argv[3], atoi(argv[1]));
+		printf("\n");
+		return (0);
+	}
+	if ( argc != 1 ) {
+		fprintf(stdout, "Usage: ./perft [depth red blue]\n");
+		return (1);
+	}
+	int failed = 0;
+	LL total = 0;
+	auto tick = std::chrono::steady_clock::now();
+	for ( auto const &k: KNOWN ) {
+		LL nodes = run(k.red, k.blue, k.depth);
+		total += nodes;
+		if ( nodes == k.nodes ) {
+			printf("  ok\n");
+		}
+		else {
+			printf("  FAIL, expected %lld\n", k.nodes);
+			++failed;
+		}
+	}
+	auto tock = std::chrono::steady_clock::now();
+	double sec = std::chrono::duration_cast<std::chrono::duration<double>>(tock-tick).count();
+	printf("total: %lld nodes %.3f s %.2f Mnps, %d failed\n", total, sec, total/sec/1e6, failed);
+	return (failed? 1: 0);
+}
@@ -0,0 +1,119 @@
+/*! \file pool.hpp
+	\brief persistent work-stealing thread pool
+	 run(n, job) calls job(0) ~ job(n-1) on the pool and the calling thread,
+	 every thread pops its own queue from the back and steals from the front
+	 of the others once it is empty
+	\course Theory of Computer Game (TCG)
+*/
+#ifndef POOL_HPP
+#define POOL_HPP
+
+#include <deque>
+#include <algorithm>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <condition_variable>
+
+struct _pool {
+	struct _queue {
+		std::mutex m;
+		std::deque<int> tasks;
+	};
+
+	int const threads; // the calling thread is worker 0
+	std::unique_ptr<_queue[]> queues;
+	std::vector<std::thread> workers;
+	std::function<void(int)> const *job = nullptr;
+	std::atomic<int> pending{0};
+	std::mutex m;
+	std::condition_variable wake, done;
+	unsigned generation = 0; // one per run()
+	bool quit = false;
+
+	explicit _pool ( int threads ) : threads(std::max(1, threads)), queues(new _queue[this->threads]) {
+		for ( int w = 1; w < this->threads; ++w ) {
+			workers.emplace_back(&_pool::loop, this, w);
+		}
+	}
+	~_pool () {
+		{
+			std::lock_guard<std::mutex> lock(m);
+			quit = true;
+		}
+		wake.notify_all();
+		for ( auto &t: workers ) { t.join(); }
+	}
+	_pool ( _pool const & ) = delete;
+	_pool &operator = ( _pool const & ) = delete;
+
+	// returns when every job(i) has returned, one run() at a time
+	void run ( int n, std::function<void(int)> const &f ) {
+		if ( n <= 0 ) { return; }
+		{
+			std::lock_guard<std::mutex> lock(m);
+			job = &f;
+			pending = n;
+			for ( int i = 0; i < n; ++i ) {
+				std::lock_guard<std::mutex> qlock(queues[i%threads].m);
+				queues[i%threads].tasks.push_back(i);
+			}
+			++generation;
+		}
+		wake.notify_all();
+		drain(0);
+		std::unique_lock<std::mutex> lock(m);
+		done.wait(lock, [this]{ return pending == 0; });
+	}
+
+private:
+	bool take ( int w, int &task ) {
+		{
+			_queue &q = queues[w];
+			std::lock_guard<std::mutex> lock(q.m);
+			if ( !q.tasks.empty() ) {
+				task = q.tasks.back();
+				q.tasks.pop_back();
+				return (true);
+			}
+		}
+		for ( int k = 1; k < threads; ++k ) {
+			_queue &q = queues[(w+k)%threads];
+			std::lock_guard<std::mutex> lock(q.m);
+			if ( !q.tasks.empty() ) {
+				task = q.tasks.front();
+				q.tasks.pop_front();
+				return (true);
+			}
+		}
+		return (false);
+	}
+	// the queues are filled after job is set, so a taken task sees its job
+	void drain ( int w ) {
+		int task;
+		while ( take(w, task) ) {
+			(*job)(task);
+			if ( --pending == 0 ) {
+				std::lock_guard<std::mutex> lock(m);
+				done.notify_all();
+			}
+		}
+	}
+	void loop ( int w ) {
+		unsigned seen = 0;
+		while ( true ) {
+			{
+				std::unique_lock<std::mutex> lock(m);
+				wake.wait(lock, [&]{ return quit || generation != seen; });
+				if ( quit ) { return; }
+				seen = generation;
+			}
+			drain(w);
+		}
+	}
+};
+
+#endif
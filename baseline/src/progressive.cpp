@@ -18,11 +18,23 @@
 #include <fstream>
 #include <utility>
 #include <chrono>
-#include <queue>
 #include <algorithm>
 #include <random>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#ifdef __SSE2__
+#include <immintrin.h>
+#endif
 
 #include "einstein.hpp"
+#include "arena.hpp"
+#ifdef leaf_parallel
+#include "pool.hpp"
+#endif
+#ifdef transposition
+#include "ttable.hpp"
+#endif
 
 // Heuristic
 const int EARLY_GAME_STEPS_THRESHOLD = 10;
@@ -37,6 +49,72 @@ const int SIMULATION_BATCH = 50;
 #else
 const int SIMULATION_BATCH = 30;
 #endif
+// search threads of the parallel modes, -D THREADS=n to fix the count
+#ifdef THREADS
+const int NUM_THREADS = THREADS;
+#else
+const int NUM_THREADS = std::max(1u, std::thread::hardware_concurrency());
+#endif
+#ifdef root_parallel
+#define TREE_LOCAL thread_local // every thread searches a tree of its own
+#else
+#define TREE_LOCAL
+#endif
+#if defined(root_parallel) && defined(tree_parallel)
+#error "root_parallel and tree_parallel are two modes, pick one"
+#endif
+#if defined(leaf_parallel) && (defined(root_parallel) || defined(tree_parallel))
+#error "leaf_parallel shares the threads with root_parallel/tree_parallel, pick one"
+#endif
+#if defined(transposition) && defined(tree_parallel)
+#error "transposition links nodes without the node locks, no tree_parallel"
+#endif
+#if defined(solver) && defined(tree_parallel)
+#error "solver proofs are updated without the node locks, no tree_parallel"
+#endif
+#if defined(scaling) && !defined(tree_parallel)
+#error "scaling benchmarks tree_parallel"
+#endif
+#ifdef tree_parallel
+// all threads search one tree: stats are atomic, and a node is locked (one of
+// NUM_LOCKS shared by id) while a child is picked or built under it
+template<class T> using STAT = std::atomic<T>;
+const int NUM_LOCKS = 4096;
+std::mutex nodeLocks[NUM_LOCKS];
+#else
+template<class T> using STAT = T;
+#endif
+template<class T> void addStat(T &s, T const &v){ s += v; }
+template<class T> void addStat(std::atomic<T> &s, T const &v){
+	T old = s.load(std::memory_order_relaxed);
+	while(!s.compare_exchange_weak(old, old+v, std::memory_order_relaxed));
+}
+#ifdef leaf_parallel
+// a leaf's playouts run on NUM_THREADS threads, the batch grows until one
+// leaf takes about LEAF_BATCH_SECONDS so the dispatch cost is paid rarely
+const double LEAF_BATCH_SECONDS = 2e-4;
+const int MAX_LEAF_BATCH = 256;
+_pool &playoutPool(){
+	static _pool pool(NUM_THREADS);
+	return pool;
+}
+// one leaf at a time: only the searching thread calls doSimulation(), the
+// pool's threads just fill result
+struct _leaf_batch {
+	double latency = 0.0; // seconds per playout per thread, moving average
+	int size = (SIMULATION_BATCH+NUM_THREADS-1)/NUM_THREADS*NUM_THREADS;
+	std::vector<float> result; // playout i of the current leaf
+
+	// n playouts took seconds on the pool, sets the next size
+	void measured(int n, double seconds){
+		double sample = seconds*NUM_THREADS/n;
+		latency = (latency == 0.0)? sample: 0.9*latency + 0.1*sample;
+		int perThread = std::max(1, int(LEAF_BATCH_SECONDS/latency));
+		size = std::min(MAX_LEAF_BATCH, perThread*NUM_THREADS);
+		size = std::max(size, NUM_THREADS);
+	}
+} leafBatch;
+#endif
 
 // PP parameters
 const int PP_MIN_SIM = 200;
@@ -53,14 +131,14 @@ const int W_SELF_EAT = 1;
 const int W_REST = 5;
 
 char start;
-char init[2][NUM_CUBE+1] = {};
-BOARD_GUI *b, tmp_b;
+std::string init[2];
 bool myturn;
 inline void flip_bit ( bool &_ ) { _ = !_; }
 char num, dir;
 std::fstream flog;
 unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-auto rng = std::mt19937(seed);
+thread_local auto rng = std::mt19937(seed + std::hash<std::thread::id>()(std::this_thread::get_id()));
+std::mutex flog_mutex; // for logs written while other threads search
 
 void logger ( std::string logfile ) {
 	flog.open(logfile, std::fstream::out);
@@ -73,22 +151,13 @@ using ULL = unsigned long long;
 using PSS = std::pair<std::string, std::string>;
 using VII = std::vector<PII>;
 
-typedef struct _POS{
-	int x;
-	int y;
-} POS;
-
-float simulation(BOARD_GUI b);
-
-POS idxToPos(const int &idx){
-	POS newPOS;
-	newPOS.x = idx/BOARD_SZ;
-	newPOS.y = idx%BOARD_SZ;
-	return newPOS;
-}
+template<class BOARD_T> float simulation(BOARD_T b);
 
-std::queue<PII> prioritizeMovelist(const BOARD_GUI &b, bool simulation = true){
-	VII ml = b.move_list();
+// fills re_ml in priority order, only the first move when simulation
+template<class BOARD_T> void prioritizeMovelist(const BOARD_T &b, typename BOARD_T::MOVE_BUFFER &re_ml, bool simulation = true){
+	const int MAX_MOVES = BOARD_T::MAX_MOVES;
+	typename BOARD_T::MOVE_BUFFER ml;
+	b.generate_moves(ml);
 	
 	std::shuffle(ml.begin(), ml.end(), rng);
 
@@ -96,19 +165,24 @@ std::queue<PII> prioritizeMovelist(const BOARD_GUI &b, bool simulation = true){
 	int SZ_eat = 0;
 	int SZ_rest = 0;
 	int SZ_eatSamller = 0;
+	int SZ_backed = 0;
 	// int SZ_bait = 0;
 
-	PII eatSelfMoves[18];
-	PII eatMoves[18];
-	PII eatSmallerMoves[18];
-	PII restMoves[18];
-	// PII baitMoves[18];
-
-	for ( auto &move: ml ) {
-		// int yummy = b.yummy(move);
+	PII eatSelfMoves[MAX_MOVES];
+	PII eatMoves[MAX_MOVES];
+	PII eatSmallerMoves[MAX_MOVES];
+	PII backedMoves[MAX_MOVES]; // quiet, more allies than opponents around
+	PII restMoves[MAX_MOVES];
+	// PII baitMoves[MAX_MOVES];
+
+	#ifdef refine
+	int eval[MAX_MOVES];
+	b.evalMoves(ml, eval);
+	#endif
+	for ( int i=0; i<ml.size(); ++i ) {
+		auto &move = ml[i];
 		#ifdef refine
-		// int yummy = b.yummy(move);
-		int yummy = b.evalMove(move);
+		int yummy = eval[i];
 		#else
 		int yummy = b.yummy(move);
 		#endif
@@ -120,6 +194,8 @@ std::queue<PII> prioritizeMovelist(const BOARD_GUI &b, bool simulation = true){
 		// 	baitMoves[SZ_bait++] = move;
 		}else if( yummy == 2 ){
 			eatSmallerMoves[SZ_eatSamller++] = move;
+		}else if( yummy == 3 ){
+			backedMoves[SZ_backed++] = move;
 		}else{
 			restMoves[SZ_rest++] = move;
 		}
@@ -127,30 +203,36 @@ std::queue<PII> prioritizeMovelist(const BOARD_GUI &b, bool simulation = true){
 
 	// auto m = ml.at(rand()%ml.size());
 	// PII m;
-	std::queue<PII> re_ml;
+	re_ml.clear();
 	
 	for(int i=0; i<SZ_eatSamller; ++i){
-		re_ml.push(eatSmallerMoves[i]);
-		if(simulation) return re_ml;
+		re_ml.push_back(eatSmallerMoves[i]);
+		if(simulation) return;
 	}
 	for(int i=0; i<SZ_eat; ++i){
-		re_ml.push(eatMoves[i]);
-		if(simulation) return re_ml;
+		re_ml.push_back(eatMoves[i]);
+		if(simulation) return;
+	}
+	for(int i=0; i<SZ_backed; ++i){
+		re_ml.push_back(backedMoves[i]);
+		if(simulation) return;
 	}
 	for(int i=0; i<SZ_rest; ++i){
-		re_ml.push(restMoves[i]);
-		if(simulation) return re_ml;
+		re_ml.push_back(restMoves[i]);
+		if(simulation) return;
 	}
 	for(int i=0; i<SZ_selfEat; ++i){
-		re_ml.push(eatSelfMoves[i]);
-		if(simulation) return re_ml;
+		re_ml.push_back(eatSelfMoves[i]);
+		if(simulation) return;
 	}
 		
-	return re_ml;
+	return;
 }
 
-std::queue<PII> stochasticPrioritizeMovelist(const BOARD_GUI &b, bool simulation = true){
-	VII ml = b.move_list();
+template<class BOARD_T> void stochasticPrioritizeMovelist(const BOARD_T &b, typename BOARD_T::MOVE_BUFFER &re_ml, bool simulation = true){
+	const int MAX_MOVES = BOARD_T::MAX_MOVES;
+	typename BOARD_T::MOVE_BUFFER ml;
+	b.generate_moves(ml);
 	
 	std::shuffle(ml.begin(), ml.end(), rng);
 
@@ -161,12 +243,11 @@ std::queue<PII> stochasticPrioritizeMovelist(const BOARD_GUI &b, bool simulation
 	int w_eat = 0;
 	int w_rest = 0;
 
-	PII eatSelfMoves[18];
-	PII eatMoves[18];
-	PII restMoves[18];
+	PII eatSelfMoves[MAX_MOVES];
+	PII eatMoves[MAX_MOVES];
+	PII restMoves[MAX_MOVES];
 
 	for ( auto &move: ml ) {
-		int yummy = b.evalMove(move);
 		if ( b.yummy(move) <= -1 ) {
 			eatSelfMoves[SZ_selfEat++] = move;
 			w_selfEat += W_SELF_EAT;
@@ -185,7 +266,7 @@ std::queue<PII> stochasticPrioritizeMovelist(const BOARD_GUI &b, bool simulation
 
 	// auto m = ml.at(rand()%ml.size());
 	// PII m;
-	std::queue<PII> re_ml;
+	re_ml.clear();
 	
 	// if(!simulation) flog << "Start sampling:" << std::endl;
 	// if(!simulation) flog << "\t";
@@ -195,7 +276,7 @@ std::queue<PII> stochasticPrioritizeMovelist(const BOARD_GUI &b, bool simulation
 		rand_num -= w_eat;
 		if(rand_num < 0){
 			// if(!simulation) flog << "e ";
-			re_ml.push(eatMoves[--SZ_eat]);
+			re_ml.push_back(eatMoves[--SZ_eat]);
 			w_eat -= W_EAT;
 			w_total -= W_EAT;
 			if(simulation) break;
@@ -204,7 +285,7 @@ std::queue<PII> stochasticPrioritizeMovelist(const BOARD_GUI &b, bool simulation
 		rand_num -= w_rest;
 		if(rand_num < 0){
 			// if(!simulation) flog << "r ";
-			re_ml.push(restMoves[--SZ_rest]);
+			re_ml.push_back(restMoves[--SZ_rest]);
 			w_rest -= W_REST;
 			w_total -= W_REST;
 			if(simulation) break;
@@ -213,103 +294,371 @@ std::queue<PII> stochasticPrioritizeMovelist(const BOARD_GUI &b, bool simulation
 		rand_num -= w_selfEat;
 		if(rand_num < 0){
 			// if(!simulation) flog << "s ";
-			re_ml.push(eatSelfMoves[--SZ_selfEat]);
+			re_ml.push_back(eatSelfMoves[--SZ_selfEat]);
 			w_selfEat -= W_SELF_EAT;
 			w_total -= W_SELF_EAT;
 			if(simulation) break;
 			continue;
 		}else{
+			std::lock_guard<std::mutex> lock(flog_mutex);
 			flog << "WTFFFFFF?!" << std::endl;
 			break; // shoudn't be here
 		}
 	}
 	// if(!simulation) flog << std::endl;
 
-	return re_ml;
+	return;
 }
 
 
-typedef struct _NODE{
-	using ULL = unsigned long long;
+// UCT scores of n children in one pass, sign is +1 for R to move and -1 for B
+// AVX2 when built with -mavx2 (or -march=native), SSE2 on any x86-64
+void uctScores(float const *value, int const *visits, int n, float sign, float logN, float *score){
+	int i = 0;
+	#ifdef __AVX2__
+	__m256 const s8 = _mm256_set1_ps(sign), l8 = _mm256_set1_ps(logN), c8 = _mm256_set1_ps(UCB_C);
+	for(; i+8<=n; i+=8){
+		__m256 inv = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_cvtepi32_ps(_mm256_loadu_si256((__m256i const*)(visits+i))));
+		__m256 exploitation = _mm256_mul_ps(_mm256_mul_ps(s8, _mm256_loadu_ps(value+i)), inv);
+		__m256 exploration = _mm256_sqrt_ps(_mm256_mul_ps(l8, inv));
+		_mm256_storeu_ps(score+i, _mm256_add_ps(exploitation, _mm256_mul_ps(c8, exploration)));
+	}
+	#endif
+	#ifdef __SSE2__
+	__m128 const s4 = _mm_set1_ps(sign), l4 = _mm_set1_ps(logN), c4 = _mm_set1_ps(UCB_C);
+	for(; i+4<=n; i+=4){
+		__m128 inv = _mm_div_ps(_mm_set1_ps(1.0f), _mm_cvtepi32_ps(_mm_loadu_si128((__m128i const*)(visits+i))));
+		__m128 exploitation = _mm_mul_ps(_mm_mul_ps(s4, _mm_loadu_ps(value+i)), inv);
+		__m128 exploration = _mm_sqrt_ps(_mm_mul_ps(l4, inv));
+		_mm_storeu_ps(score+i, _mm_add_ps(exploitation, _mm_mul_ps(c4, exploration)));
+	}
+	#endif
+	for(; i<n; ++i){
+		float inv = 1.0f / visits[i];
+		score[i] = sign * value[i] * inv + UCB_C * sqrtf(logN * inv);
+	}
+}
+
+// win rate (i.t.o. R) and standard deviation of n children in one pass, for
+// progressive pruning, a negative variance from rounding gives NaN as before
+void ppStats(float const *value, float const *sumOfSquaredValue, int const *visits, int n, float *winRate, float *stdDev){
+	int i = 0;
+	#ifdef __AVX2__
+	for(; i+8<=n; i+=8){
+		__m256 inv = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_cvtepi32_ps(_mm256_loadu_si256((__m256i const*)(visits+i))));
+		__m256 mean = _mm256_mul_ps(_mm256_loadu_ps(value+i), inv);
+		__m256 var = _mm256_sub_ps(_mm256_mul_ps(_mm256_loadu_ps(sumOfSquaredValue+i), inv), _mm256_mul_ps(mean, mean));
+		_mm256_storeu_ps(winRate+i, mean);
+		_mm256_storeu_ps(stdDev+i, _mm256_sqrt_ps(var));
+	}
+	#endif
+	#ifdef __SSE2__
+	for(; i+4<=n; i+=4){
+		__m128 inv = _mm_div_ps(_mm_set1_ps(1.0f), _mm_cvtepi32_ps(_mm_loadu_si128((__m128i const*)(visits+i))));
+		__m128 mean = _mm_mul_ps(_mm_loadu_ps(value+i), inv);
+		__m128 var = _mm_sub_ps(_mm_mul_ps(_mm_loadu_ps(sumOfSquaredValue+i), inv), _mm_mul_ps(mean, mean));
+		_mm_storeu_ps(winRate+i, mean);
+		_mm_storeu_ps(stdDev+i, _mm_sqrt_ps(var));
+	}
+	#endif
+	for(; i<n; ++i){
+		float inv = 1.0f / visits[i];
+		float mean = value[i] * inv;
+		winRate[i] = mean;
+		stdDev[i] = sqrtf(sumOfSquaredValue[i] * inv - mean * mean);
+	}
+}
+
+// a node keeps its edge only, the board is replayed from the root
+// stats are arrays parallel to arena (same ids), so a node's children have
+// their values/visits side by side
+// -D transposition: a child whose position is already in the tree is an
+// alias of that node (link), selection goes on from there and the stats
+// are the owner's, promote() puts the kept nodes back in the table
+// -D solver: game results found in the tree are proven up (MCTS-Solver),
+// a lost move is pruned and a solved root ends the search
+template<class BOARD_T> struct _NODE{
 	using PII = std::pair<int, int>;
-	using PSS = std::pair<std::string, std::string>;
-	using VII = std::vector<PII>;
+	using MOVE_BUFFER = typename BOARD_T::MOVE_BUFFER;
+	static constexpr int MAX_MOVES = BOARD_T::MAX_MOVES;
 	
-	_NODE* parent;
-	float value;
-	float sumOfSquaredValue;
-	int num_visits;
-	bool pruned;
-	int numChildLeft;
-	BOARD_GUI board;
-	std::vector<_NODE*> child;
-	std::queue<PII> moveToExpand;
-	// VII movedList; // used for debug
+	using ARENA = _arena<_NODE>;
+	static constexpr uint32_t NIL = ARENA::NIL;
+	static TREE_LOCAL ARENA arena; // every node of the tree, released at once by reset()
+	static TREE_LOCAL _arena<STAT<float>> value;
+	static TREE_LOCAL _arena<STAT<float>> sumOfSquaredValue;
+	static TREE_LOCAL _arena<STAT<int>> num_visits;
+	// the tree before the last promote(), copied from and then dropped
+	static TREE_LOCAL ARENA oldArena;
+	static TREE_LOCAL _arena<STAT<float>> oldValue;
+	static TREE_LOCAL _arena<STAT<float>> oldSumOfSquaredValue;
+	static TREE_LOCAL _arena<STAT<int>> oldNum_visits;
+	#ifdef transposition
+	static TREE_LOCAL _ttable<> table; // position key -> owner, least visited replaced
+	static TREE_LOCAL int numTranspositions;
+	// the arena is bounded too, a node without children stays a leaf once
+	// its children would pass MAX_NODES (about 250 MB with the stats)
+	static constexpr uint32_t MAX_NODES = uint32_t(1)<<22;
+	#endif
+
+	uint32_t parent; // id in arena
+	uint32_t first_child; // children are arena[first_child ~ first_child+numMoves-1], NIL until the first expansion
+	uint32_t prunedMask; // bit i for child i
+	uint8_t move; // the move from parent to here, num<<4|dir
+	int8_t numChildLeft;
+	int8_t numExpanded; // moveToExpand[0 ~ numExpanded-1] have been expanded
+	int8_t numMoves;
+	uint8_t moveToExpand[MAX_MOVES]; // in expansion order, packed like move
+	#ifdef transposition
+	uint32_t link; // NIL, or the node of the same position that keeps the stats
+	uint32_t aliasMask; // bit i for child i with a link
+	#endif
+	#ifdef solver
+	int8_t proven; // 1: the move to here wins, -1: it loses, 0: not proven
+	#endif
 
 	_NODE(){}
 
-	float getStdDev(){
-		return sqrt((sumOfSquaredValue / num_visits) - pow(value/num_visits, 2));
+	// ids of n consecutive nodes with their stats
+	static uint32_t alloc(uint32_t n = 1){
+		#ifdef tree_parallel
+		static std::mutex allocLock;
+		std::lock_guard<std::mutex> lock(allocLock);
+		#endif
+		uint32_t id = arena.alloc(n);
+		value.alloc(n);
+		sumOfSquaredValue.alloc(n);
+		num_visits.alloc(n);
+		return id;
+	}
+	static void reset(){
+		arena.reset();
+		value.reset();
+		sumOfSquaredValue.reset();
+		num_visits.reset();
+		#ifdef transposition
+		table.clear();
+		numTranspositions = 0;
+		#endif
+	}
+	// the node keeping id's stats, id itself unless it is an alias
+	static uint32_t owner(uint32_t id){
+		#ifdef transposition
+		if(id != NIL && arena[id].link != NIL) return arena[id].link;
+		#endif
+		return id;
+	}
+
+	// makes the subtree of id the whole tree, it is copied into fresh
+	// arenas (children stay consecutive) and everything else is dropped
+	// board is the position at id
+	static uint32_t promote(uint32_t id, BOARD_T board){
+		std::swap(arena, oldArena);
+		std::swap(value, oldValue);
+		std::swap(sumOfSquaredValue, oldSumOfSquaredValue);
+		std::swap(num_visits, oldNum_visits);
+		reset();
+		uint32_t root = alloc();
+		copyTree(id, root, NIL, board);
+		return root;
+	}
+	// board is the position at from, and at to once copied
+	static void copyTree(uint32_t from, uint32_t to, uint32_t p, BOARD_T &board){
+		_NODE &n = arena[to];
+		n = oldArena[from];
+		n.parent = p;
+		uint32_t src = from;
+		#ifdef transposition
+		// the copied nodes go back into the (cleared) table, an alias links
+		// to its owner's copy if that came first in this walk, otherwise it
+		// becomes an owner (never expanded) with its old owner's stats
+		bool alias = (n.link != NIL);
+		if(alias) src = n.link;
+		n.link = NIL;
+		n.aliasMask = 0;
+		#endif
+		#ifdef solver
+		n.proven = oldArena[src].proven;
+		#endif
+		value[to] = static_cast<float>(oldValue[src]);
+		sumOfSquaredValue[to] = static_cast<float>(oldSumOfSquaredValue[src]);
+		num_visits[to] = static_cast<int>(oldNum_visits[src]);
+		#ifdef transposition
+		// the old tree can hold several owners of a position, the first
+		// copied keeps the entry
+		uint32_t o = table.find(board.key);
+		if(alias && o != NIL){
+			n.link = o;
+			arena[p].aliasMask |= uint32_t(1)<<(to-arena[p].first_child);
+		}else if(o == NIL){
+			table.insert(board.key, to, [](uint32_t id){ return num_visits[id]; });
+		}
+		#endif
+		if(n.first_child == NIL) return;
+		uint32_t old_first = n.first_child;
+		n.first_child = alloc(n.numMoves);
+		for(int i=0; i<n.numExpanded; ++i){
+			#ifdef transposition
+			auto undo = board.apply_move(oldArena[old_first+i].getMove());
+			copyTree(old_first+i, n.first_child+i, to, board);
+			board.undo_move(undo);
+			#else
+			copyTree(old_first+i, n.first_child+i, to, board);
+			#endif
+		}
+	}
+	// expanded child reached by m, NIL if none
+	uint32_t findChild(PII const &m){
+		for(int i=0; i<numExpanded; ++i){
+			if(arena[first_child+i].move == pack(m)){
+				return first_child+i;
+			}
+		}
+		return NIL;
+	}
+	// a reused root only searches the moves in ml, the children of the
+	// others are pruned and their unexpanded moves dropped
+	void restrictMoves(MOVE_BUFFER const &ml){
+		auto allowed = [&](uint8_t m){
+			for(auto &move: ml){
+				if(pack(move) == m) return true;
+			}
+			return false;
+		};
+		for(int i=0; i<numExpanded; ++i){
+			if(!pruned(i) && !allowed(arena[first_child+i].move)){
+				prunedMask |= uint32_t(1)<<i;
+				--numChildLeft;
+			}
+		}
+		if(numChildLeft == 0){ // progressive pruning took the rest before
+			for(int i=0; i<numExpanded; ++i){
+				if(allowed(arena[first_child+i].move)){
+					prunedMask &= ~(uint32_t(1)<<i);
+					++numChildLeft;
+				}
+			}
+		}
+		int k = numExpanded;
+		for(int i=numExpanded; i<numMoves; ++i){
+			if(allowed(moveToExpand[i])){
+				moveToExpand[k++] = moveToExpand[i];
+			}
+		}
+		numMoves = k;
 	}
 
-	float getWinRate(){
-		// flog << "value: " << value << ", num_visit: " << (float)num_visits << std::endl;
-		return (value / (float)num_visits);
+	static uint8_t pack(PII const &m){
+		return (m.first<<4 | m.second);
+	}
+	static PII unpack(uint8_t m){
+		return std::make_pair(m>>4, m&15);
+	}
+	PII getMove(){
+		return unpack(move);
+	}
+	void setMoves(MOVE_BUFFER const &ml){
+		numMoves = ml.size();
+		for(int i=0; i<numMoves; ++i){
+			moveToExpand[i] = pack(ml[i]);
+		}
+	}
+	bool pruned(int i){
+		return (prunedMask>>i & 1);
+	}
+	// children's stats are in one slab, see _arena::alloc()
+	void prefetch(){
+		if(first_child == NIL) return;
+		__builtin_prefetch(&value[first_child]);
+		__builtin_prefetch(&sumOfSquaredValue[first_child]);
+		__builtin_prefetch(&num_visits[first_child]);
 	}
 
-	_NODE* getBestChild(bool decideMove = false){
+	// id of the child to descend to, turn is the side to move here
+	uint32_t getBestChild(uint32_t self, bool turn, bool decideMove = false){
+		if(first_child == NIL) return NIL;
+		#ifdef transposition
+		// aliased children take their owners' stats before they are compared
+		for(uint32_t m=aliasMask; m; m&=m-1){
+			uint32_t c = first_child + __builtin_ctz(m);
+			uint32_t o = arena[c].link;
+			value[c] = value[o];
+			sumOfSquaredValue[c] = sumOfSquaredValue[o];
+			num_visits[c] = num_visits[o];
+		}
+		#endif
+		#ifdef tree_parallel
+		float childValue[MAX_MOVES] = {};
+		float childSumOfSquaredValue[MAX_MOVES] = {};
+		int childVisits[MAX_MOVES] = {};
+		for(int i=0; i<numExpanded; ++i){
+			childValue[i] = value[first_child+i].load(std::memory_order_relaxed);
+			childSumOfSquaredValue[i] = sumOfSquaredValue[first_child+i].load(std::memory_order_relaxed);
+			childVisits[i] = num_visits[first_child+i].load(std::memory_order_relaxed);
+		}
+		#else
+		float const *childValue = &value[first_child];
+		float const *childSumOfSquaredValue = &sumOfSquaredValue[first_child];
+		int const *childVisits = &num_visits[first_child];
+		#endif
 		
 		// Edge cases check
-		if(child.size() == 1){
+		if(numExpanded == 1){
 			// flog << "Only one child" << std::endl;
-			return child[0];
+			return first_child;
 		}else if(numChildLeft == 1){
-			for(int i=0; i<child.size(); ++i){
-				if(!child[i]->pruned){
-					return child[i];
+			for(int i=0; i<numExpanded; ++i){
+				if(!pruned(i)){
+					return first_child+i;
 				}
 			}
 		}
 
 		// Progressive Pruning
+		// - win rates and deviations come from one vectorised pass, like the UCT scores
 		if(!decideMove){
-			std::vector<int> vIdxForPP;
-			for(int i=0; i<child.size(); ++i){
+			float winRate[MAX_MOVES];
+			float stdDev[MAX_MOVES];
+			ppStats(childValue, childSumOfSquaredValue, childVisits, numExpanded, winRate, stdDev);
+			int vIdxForPP[MAX_MOVES];
+			int SZ_PP = 0;
+			for(int i=0; i<numExpanded; ++i){
 				// hard pruning
-				if(!child[i]->pruned && 
-					child[i]->num_visits >= PP_MIN_SIM &&
-					child[i]->getStdDev() < PP_SIGMA_EPSILON){
+				if(!pruned(i) && 
+					childVisits[i] >= PP_MIN_SIM &&
+					stdDev[i] < PP_SIGMA_EPSILON){
 					// flog << "Found confident candidate" << std::endl;
-					vIdxForPP.push_back(i);
+					vIdxForPP[SZ_PP++] = i;
 				}
 			}
-			if(vIdxForPP.size() > 1){
-				float bestWinRate = child[vIdxForPP[0]]->getWinRate();
+			if(SZ_PP > 1){
+				float bestWinRate = winRate[vIdxForPP[0]];
 				int bestIdx = vIdxForPP[0];
 				float lowerBound;
-				for(int i=1; i<vIdxForPP.size(); ++i){
-					float tmp_winrate = child[vIdxForPP[i]]->getWinRate();
+				for(int i=1; i<SZ_PP; ++i){
+					float tmp_winrate = winRate[vIdxForPP[i]];
 					if(tmp_winrate > bestWinRate){
 						bestWinRate = tmp_winrate;
 						bestIdx = vIdxForPP[i];
 					}
 				}
 				
-				// flog << "best win rate: " << bestWinRate << ", stdDev: " << child[bestIdx]->getStdDev() << std::endl;
-				lowerBound = bestWinRate - (PP_NUM_SIGMA * child[bestIdx]->getStdDev());
-				for(int i=0; i<vIdxForPP.size(); ++i){
+				// flog << "best win rate: " << bestWinRate << ", stdDev: " << stdDev[bestIdx] << std::endl;
+				lowerBound = bestWinRate - (PP_NUM_SIGMA * stdDev[bestIdx]);
+				for(int i=0; i<SZ_PP; ++i){
 					if(vIdxForPP[i] == bestIdx){
 						continue;
 					}
 
-					float tmp_winrate = child[vIdxForPP[i]]->getWinRate();
-					float tmp_stdDev = child[vIdxForPP[i]]->getStdDev();
+					float tmp_winrate = winRate[vIdxForPP[i]];
+					float tmp_stdDev = stdDev[vIdxForPP[i]];
 					float confidentUpperBound = tmp_winrate + (PP_NUM_SIGMA * tmp_stdDev);
 
 					// flog << "Lower bound: " << lowerBound << " | upper: " << confidentUpperBound << std::endl;					
 					if(lowerBound > confidentUpperBound){
-						child[vIdxForPP[i]]->pruned = true;
+						prunedMask |= uint32_t(1)<<vIdxForPP[i];
 						--numChildLeft;
+						std::lock_guard<std::mutex> lock(flog_mutex);
 						flog << "\tPruned one child lower: " << lowerBound << " | upper: " << confidentUpperBound << std::endl;
 
 					}
@@ -319,218 +668,247 @@ typedef struct _NODE{
 
 		// Getting best child
 		float bestUCB = -99999.0;
-		_NODE* bestChild = NULL;
-
-		bool turn = board._turn;
+		uint32_t bestChild = NIL;
 
-		// flog << "\tGetting best child..., child size: " << child.size() << std::endl;
+		// flog << "\tGetting best child..., child size: " << numExpanded << std::endl;
 		if(decideMove){
-			for(int i=0; i<child.size(); ++i){
+			#ifdef solver
+			for(int i=0; i<numExpanded; ++i){
+				if(arena[owner(first_child+i)].proven > 0){
+					flog << "Proven win" << std::endl;
+					return first_child+i;
+				}
+			}
+			#endif
+			for(int i=0; i<numExpanded; ++i){
 				// Skip pruned children
-				if(child[i]->pruned) continue;
+				if(pruned(i)) continue;
 				
-				float winRate = (turn == 0)? (float)child[i]->value / (child[i]->num_visits) : -(float)child[i]->value / (child[i]->num_visits);
-				PII lastMove = child[i]->board.getLastMove();
-				flog << "[" << lastMove.first << ", " << lastMove.second << "] WinRate: " << winRate << ", num_visits: " << child[i]->num_visits << std::endl;
+				float winRate = (turn == 0)? (float)childValue[i] / (childVisits[i]) : -(float)childValue[i] / (childVisits[i]);
+				PII lastMove = arena[first_child+i].getMove();
+				flog << "[" << lastMove.first << ", " << lastMove.second << "] WinRate: " << winRate << ", num_visits: " << childVisits[i] << std::endl;
 				// flog << "\t\tUCT score: " << uct_score << std::endl;
 
 				if(winRate > bestUCB){
-					bestChild = child[i];
+					bestChild = first_child+i;
 					bestUCB = winRate;
 				}
 			}
+			#ifdef solver
+			if(bestChild == NIL){ // every move is proven lost, the best looking one is played
+				for(int i=0; i<numExpanded; ++i){
+					float winRate = (turn == 0)? (float)childValue[i] / (childVisits[i]) : -(float)childValue[i] / (childVisits[i]);
+					if(winRate > bestUCB){
+						bestChild = first_child+i;
+						bestUCB = winRate;
+					}
+				}
+			}
+			#endif
 		}else{
-			for(int i=0; i<child.size(); ++i){
+			float uct_score[MAX_MOVES];
+			uctScores(childValue, childVisits, numExpanded, (turn == 0)? 1.0f: -1.0f, log((float)num_visits[self]), uct_score);
+			for(int i=0; i<numExpanded; ++i){
 				// Skip pruned children
-				if(child[i]->pruned) continue;
-
-				float uct_exploitation = (turn == 0)? (float)child[i]->value / (child[i]->num_visits) : -(float)child[i]->value / (child[i]->num_visits);
-				float uct_exploration = sqrt( log((float)num_visits) / (child[i]->num_visits) );
-				float uct_score = uct_exploitation + UCB_C * uct_exploration;
+				if(pruned(i)) continue;
 
-				// flog << "\t\tUCT score: " << uct_score << std::endl;
+				// flog << "\t\tUCT score: " << uct_score[i] << std::endl;
 
-				if(uct_score > bestUCB){
-					bestChild = child[i];
-					bestUCB = uct_score;
+				if(uct_score[i] > bestUCB){
+					bestChild = first_child+i;
+					bestUCB = uct_score[i];
 				}
 			}
 		}
-		// flog << "\tGetting best child..., child: " << (bestChild == NULL) << " | " << bestUCB << std::endl;
+		// flog << "\tGetting best child..., child: " << (bestChild == NIL) << " | " << bestUCB << std::endl;
 		return bestChild;
 	}
 
-	void construct(BOARD_GUI b, _NODE* p){
-		board = b;
+	void construct(uint32_t self, uint32_t p, PII const &m){
 		parent = p;
-		num_visits = 0;
+		first_child = NIL;
+		prunedMask = 0;
+		move = pack(m);
 		numChildLeft = 0;
-		value = 0.0;
-		sumOfSquaredValue = 0.0;
-		pruned = false;
-	}
-
-	_NODE* addChildWithMove(PII &m){
-		// flog << "adding child... " << board.send_move(m) << std::endl;
-		_NODE* newNode = new _NODE;
-		// flog << "adding child...0" << std::endl;
-		newNode->construct(board, this);
-
-		// BOARD_GUI b_tmp = newNode->board;
-		// auto ml = b_tmp.move_list();
-		// flog << "==========MoveList========== P:" << enum2int(b_tmp.turn()) << std::endl;
-		// for(int i=0; i<ml.size(); ++i){
-		// 	flog << "[" << ml.at(i).first << ", " << ml.at(i).second << "] ";
-		// }
-		// flog << std::endl << "==========MoveList==========" << std::endl;
-		// for(int i=0; i<6; ++i){
-		// 	for(int j=0; j<6; ++j){
-		// 		int idx = (i*6)+j;
-		// 		if(!b_tmp.now[idx].c){
-		// 			flog << "  ";
-		// 		}else if(b_tmp.now[idx].c->c == Color::R){
-		// 			char c = b_tmp.now[idx].c->num + 'A';
-		// 			flog << c << ' ';
-		// 		}else{
-		// 			flog << b_tmp.now[idx].c->num << ' ';
-		// 		}
-		// 	}
-		// 	flog << std::endl;
-		// }
-
-		// flog << "adding child...1" << std::endl;
-		newNode->board.do_move(m);
-		
-		// #ifdef pr
-		#ifdef sto
-		newNode->moveToExpand = stochasticPrioritizeMovelist(newNode->board, false);
-		#else
-		newNode->moveToExpand = prioritizeMovelist(newNode->board, false);
+		numExpanded = 0;
+		numMoves = 0;
+		#ifdef transposition
+		link = NIL;
+		aliasMask = 0;
 		#endif
-		// #else
-		// VII ml = newNode->board.move_list();
-		// std::shuffle(ml.begin(), ml.end(), rng);
-		// for(PII &move: ml)
-		// 	newNode->moveToExpand.push(move);
-		// // auto rng = std::default_random_engine {};
-		// #endif
-
-		// flog << "adding child...2" << std::endl;
-		child.push_back(newNode);
-		// flog << "adding child...3" << std::endl;
-		return newNode;
-	}
-
-	void expandOneLevel(){
-		auto ml = board.move_list();
-		for(int i=0; i<ml.size(); ++i){
-			auto m = ml.at(i);
-			_NODE* newNode = addChildWithMove(m);
-			child.push_back(newNode);
-		}
+		#ifdef solver
+		proven = 0;
+		#endif
+		value[self] = 0.0;
+		sumOfSquaredValue[self] = 0.0;
+		num_visits[self] = 0;
 	}
 
-	_NODE* expandOneLeaf(){
-		if(fullExpanded()) return NULL;
-		else{
-			
-			// flog << "==========MoveList========== P:" << enum2int(board.turn()) << "(in expandOneLeaf)" << std::endl;
-			// for(int i=0; i<moveToExpand.size(); ++i){
-			// 	flog << "[" << moveToExpand.at(i).first << ", " << moveToExpand.at(i).second << "] ";
-			// }
-			// flog << std::endl << "==========MoveList==========" << std::endl;
-			
-			// for(int i=0; i<movedList.size(); ++i){
-			// 	flog << "[" << movedList.at(i).first << ", " << movedList.at(i).second << "] ";
-			// }
-			// flog << std::endl << "==========MovedList==========" << std::endl;
-
-
-			// flog << "expanding..." << std::endl;
-			auto m = moveToExpand.front();
-			// movedList.push_back(m);
-			// flog << "expanding...0" << std::endl;
-			moveToExpand.pop();
-			// flog << "expanding...1" << std::endl;
-			_NODE* newChild = addChildWithMove(m);
-			++numChildLeft;
-			// flog << "expanding...2" << std::endl;
-			return newChild;
+	// builds the next child in moveToExpand, board goes from here to the child
+	uint32_t expandOneLeaf(uint32_t self, BOARD_T &board){
+		if(fullExpanded()) return NIL;
+		if(first_child == NIL){
+			first_child = alloc(numMoves);
 		}
-	}
+		uint32_t id = first_child + numExpanded;
+		PII m = unpack(moveToExpand[numExpanded++]);
+		++numChildLeft;
+
+		_NODE &newNode = arena[id];
+		newNode.construct(id, self, m);
+		#ifdef solver
+		bool mover = board._turn;
+		#endif
+		board.apply_move(m);
+		#ifdef solver
+		if(board.state() == 1 || board.state() == 2){
+			newNode.proven = ((board.state() == 1) == (mover == 0))? 1: -1;
+		}
+		#endif
 
-	_move getBestMove(){
-		return getBestChild()->board.history.back();
+		MOVE_BUFFER ml;
+		#ifdef sto
+		stochasticPrioritizeMovelist(board, ml, false);
+		#else
+		prioritizeMovelist(board, ml, false);
+		#endif
+		newNode.setMoves(ml);
+		#ifdef transposition
+		uint32_t o = table.find(board.key);
+		if(o != NIL){
+			newNode.link = o;
+			aliasMask |= uint32_t(1)<<(numExpanded-1);
+			++numTranspositions;
+		}else{
+			table.insert(board.key, id, [](uint32_t n){ return num_visits[n]; });
+		}
+		#endif
+		return id;
 	}
 
-	void doSimulation(int batchSize = SIMULATION_BATCH){
+	// board is the position of this node, returns the playouts done
+	// the results go up the parents, or path[depth ~ 0] if given
+	int doSimulation(uint32_t self, BOARD_T const &board, int batchSize = SIMULATION_BATCH, uint32_t const *path = nullptr, int depth = 0){
 		float additionalSimVal = 0.0;
 		float additionalSimValSquare = 0.0;
 
+		#ifdef leaf_parallel
+		// independent playouts, reduced here before the one walk up
+		batchSize = leafBatch.size;
+		std::vector<float> &simVal = leafBatch.result;
+		simVal.resize(batchSize);
+		auto tick = std::chrono::steady_clock::now();
+		playoutPool().run(batchSize, [&](int i){ simVal[i] = simulation(board); });
+		auto tock = std::chrono::steady_clock::now();
+		leafBatch.measured(batchSize, std::chrono::duration_cast<std::chrono::duration<double>>(tock-tick).count());
+		for(int i=0; i<batchSize; ++i){
+			additionalSimVal += simVal[i];
+			additionalSimValSquare += pow(simVal[i], 2.0);
+		}
+		#else
 		for(int i=0; i<batchSize; ++i){
 			float simVal = simulation(board);
 			additionalSimVal += simVal;
 			additionalSimValSquare += pow(simVal, 2.0);
 		}
+		#endif
 
-		_NODE* node = this;
-		while(node){
-			node->num_visits += batchSize;
-			node->value += additionalSimVal;
-			node->sumOfSquaredValue += additionalSimValSquare;
-			node = node->parent;
+		auto update = [&](uint32_t id){
+			addStat(num_visits[id], batchSize);
+			addStat(value[id], additionalSimVal);
+			addStat(sumOfSquaredValue[id], additionalSimValSquare);
+		};
+		if(path != nullptr){
+			for(int i=depth; i>=0; --i) update(path[i]);
+		}else{
+			for(uint32_t id=self; id!=NIL; id=arena[id].parent) update(id);
 		}
 
-		return;
-	}
-
-	// 0 = not over
-	// 1 = player R wins, 2 = player B wins, 3 = draw
-	bool isTerminal(){
-		return (board.state() != 0);
+		return batchSize;
 	}
 
 	bool fullExpanded(){
-		return (moveToExpand.size() == 0);
+		return (numExpanded == numMoves);
+	}
+	// room for this node's children
+	bool mayExpand(){
+		#ifdef transposition
+		if(first_child == NIL && arena.size()+numMoves > MAX_NODES) return false;
+		#endif
+		return true;
 	}
-} NODE;
 
-void freeMemNode(NODE* root){
-	
-	if(root == NULL){
-		return;
-	}else{
-		for(int i=0; i<root->child.size(); ++i){
-			freeMemNode(root->child[i]);
+	#ifdef solver
+	// proof from the children: a winning move wins here, and here is lost
+	// when every move is expanded and loses, the lost moves are pruned
+	void updateProof(){
+		if(proven != 0 || first_child == NIL) return;
+		bool allLost = fullExpanded();
+		for(int i=0; i<numExpanded; ++i){
+			int8_t p = arena[owner(first_child+i)].proven;
+			if(p > 0){
+				proven = -1;
+				return;
+			}
+			if(p < 0){
+				if(!pruned(i)){
+					prunedMask |= uint32_t(1)<<i;
+					--numChildLeft;
+				}
+			}else{
+				allLost = false;
+			}
+		}
+		if(allLost){
+			proven = 1;
+		}else if(numChildLeft == 0){ // progressive pruning took the unproven ones
+			for(int i=0; i<numExpanded; ++i){
+				if(pruned(i) && arena[owner(first_child+i)].proven == 0){
+					prunedMask &= ~(uint32_t(1)<<i);
+					++numChildLeft;
+				}
+			}
 		}
-		delete root;
 	}
+	#endif
+};
+template<int SZ> using NODE = _NODE<_position<SZ>>;
+
+template<class BOARD_T> TREE_LOCAL _arena<_NODE<BOARD_T>> _NODE<BOARD_T>::arena;
+template<class BOARD_T> TREE_LOCAL _arena<STAT<float>> _NODE<BOARD_T>::value;
+template<class BOARD_T> TREE_LOCAL _arena<STAT<float>> _NODE<BOARD_T>::sumOfSquaredValue;
+template<class BOARD_T> TREE_LOCAL _arena<STAT<int>> _NODE<BOARD_T>::num_visits;
+template<class BOARD_T> TREE_LOCAL _arena<_NODE<BOARD_T>> _NODE<BOARD_T>::oldArena;
+template<class BOARD_T> TREE_LOCAL _arena<STAT<float>> _NODE<BOARD_T>::oldValue;
+template<class BOARD_T> TREE_LOCAL _arena<STAT<float>> _NODE<BOARD_T>::oldSumOfSquaredValue;
+template<class BOARD_T> TREE_LOCAL _arena<STAT<int>> _NODE<BOARD_T>::oldNum_visits;
+#ifdef transposition
+template<class BOARD_T> TREE_LOCAL _ttable<> _NODE<BOARD_T>::table;
+template<class BOARD_T> TREE_LOCAL int _NODE<BOARD_T>::numTranspositions;
+#endif
 
-	return;
-}
-
-float simulation(BOARD_GUI b){
+template<class BOARD_T> float simulation(BOARD_T b){
 	// bool turn = b._turn; // simulation i.t.o red/blue
 	using PII = std::pair<int, int>;
 	using VII = std::vector<PII>;
-	bool isEarlyGame = (b.history.size() < 25);
+	bool isEarlyGame = (2*(b.turn_cnt-1)+b._turn < 25); // moves played so far
 	
 	// if(!isEarlyGame) flog << "yummy: ";
+	typename BOARD_T::MOVE_BUFFER ml;
 	while(b.state() == 0){
 		// TODO some good random
-		std::queue<PII> ml;
 
 		#ifdef refine
 		// if(isEarlyGame){
-		ml = prioritizeMovelist(b);
+		prioritizeMovelist(b, ml);
 		// }else{
-		// 	ml = stochasticPrioritizeMovelist(b);
+		// 	stochasticPrioritizeMovelist(b, ml);
 		// }
 		#else
-		ml = prioritizeMovelist(b);
+		prioritizeMovelist(b, ml);
 		#endif
-		// if(!isEarlyGame) flog << b.yummy(ml.front()) << " ";
-		b.do_move(ml.front());
+		// if(!isEarlyGame) flog << b.yummy(ml[0]) << " ";
+		b.apply_move(ml[0]);
 	}
 	// if(!isEarlyGame) flog << std::endl;
 
@@ -549,202 +927,544 @@ float simulation(BOARD_GUI b){
 	return res;
 }
 
-int main () 
-{
-#ifdef sto
-	logger(".log.progressive_sto");
-#elif pr
-	logger(".log.progressive_pr");
-#elif refine
-	logger(".log.progressive_refine");
-#else
-	logger(".log.progressive");
-#endif
-	auto timer = [] ( bool reset = false ) -> double {
-		static decltype(std::chrono::steady_clock::now()) tick, tock;
-		if ( reset ) {
-			tick = std::chrono::steady_clock::now();
-			return (0);
+double timer ( bool reset = false ) {
+	static decltype(std::chrono::steady_clock::now()) tick;
+	if ( reset ) {
+		tick = std::chrono::steady_clock::now();
+		return (0);
+	}
+	auto tock = std::chrono::steady_clock::now();
+	return (std::chrono::duration_cast<std::chrono::duration<double>>(tock-tick).count());
+}
+
+#ifdef tree_parallel
+// one select/expand/simulate/backprop from root_id, returns the depth reached
+// and adds the playouts to iteration
+// safe to run on many threads at once: a thread going down to a node adds
+// SIMULATION_BATCH visits there that lose for the side who moved to it
+// (virtual loss), so the other threads spread over the siblings until the
+// playouts' results replace them
+template<int SZ> int searchOnce(uint32_t root_id, _position<SZ> const &rootBoard, int &node_expanded, int &iteration){
+	using NODE_T = NODE<SZ>;
+	auto &arena = NODE_T::arena;
+	uint32_t path[_board<SZ>::MAX_GAME_LENGTH+1];
+	float sign[_board<SZ>::MAX_GAME_LENGTH+1]; // 1 if R moved to path[i], -1 if B, 0 for the root
+	int depthSofar = 0;
+	_position<SZ> board = rootBoard;
+	path[0] = root_id;
+	sign[0] = 0.0;
+	addStat(NODE_T::num_visits[root_id], SIMULATION_BATCH);
+
+	// Step 1: SELECT, Step 2: EXPAND
+	// - one locked step per level, descend to the best child or build the next one
+	while(board.state() == 0) {
+		uint32_t node = path[depthSofar];
+		float s = (board._turn == 0)? 1.0: -1.0;
+		bool expanded = false;
+		uint32_t next;
+		{
+			std::lock_guard<std::mutex> lock(nodeLocks[node%NUM_LOCKS]);
+			if(arena[node].fullExpanded()){
+				next = arena[node].getBestChild(node, board._turn);
+				if(next == NODE_T::NIL) break;
+				board.apply_move(arena[next].getMove());
+			}else{
+				next = arena[node].expandOneLeaf(node, board);
+				expanded = true;
+			}
+			// virtual loss, before the others can see the child
+			addStat(NODE_T::num_visits[next], SIMULATION_BATCH);
+			addStat(NODE_T::value[next], -s*SIMULATION_BATCH);
+		}
+		path[++depthSofar] = next;
+		sign[depthSofar] = s;
+		if(expanded){
+			++node_expanded;
+			break;
+		}
+	}
+
+	// Step 3: SIMULATE
+	float additionalSimVal = 0.0;
+	float additionalSimValSquare = 0.0;
+	for(int i=0; i<SIMULATION_BATCH; ++i){
+		float simVal = simulation(board);
+		additionalSimVal += simVal;
+		additionalSimValSquare += pow(simVal, 2.0);
+	}
+
+	// Step 4: BACK PROPAGATE, the visits were counted on the way down
+	for(int i=depthSofar; i>=0; --i){
+		addStat(NODE_T::value[path[i]], additionalSimVal + sign[i]*SIMULATION_BATCH);
+		addStat(NODE_T::sumOfSquaredValue[path[i]], additionalSimValSquare);
+	}
+	iteration += SIMULATION_BATCH;
+	return depthSofar;
+}
+
+// searchOnce() on threads threads until seconds pass or max_iteration (0:
+// unlimited) simulations are done in total, returns the simulations
+template<int SZ> int treeParallelSearch(uint32_t root_id, _position<SZ> const &rootBoard, int threads, double seconds, int max_iteration, int &node_expanded, int &max_depth){
+	std::atomic<int> iteration(0);
+	std::atomic<bool> stop(false);
+	std::vector<int> expanded(threads, 0);
+	std::vector<int> depth(threads, -1);
+	auto tick = std::chrono::steady_clock::now();
+	auto worker = [&](int t){
+		while(!stop){
+			int n = 0;
+			depth[t] = std::max(depth[t], searchOnce(root_id, rootBoard, expanded[t], n));
+			int done = (iteration += n);
+			double sec = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now()-tick).count();
+			if((seconds > 0.0 && sec >= seconds) || (max_iteration > 0 && done >= max_iteration)){
+				stop = true;
+			}
 		}
-		tock = std::chrono::steady_clock::now();
-		return (std::chrono::duration_cast<std::chrono::duration<double>>(tock-tick).count());
 	};
+	std::vector<std::thread> pool;
+	for(int t=1; t<threads; ++t){
+		pool.emplace_back(worker, t);
+	}
+	worker(0);
+	for(auto &th: pool){
+		th.join();
+	}
+	for(int t=0; t<threads; ++t){
+		node_expanded += expanded[t];
+		max_depth = std::max(max_depth, depth[t]);
+	}
+	return iteration;
+}
+#else
+// one select/expand/simulate/backprop from root_id, returns the depth reached
+// and adds the playouts to iteration
+template<int SZ> int searchOnce(uint32_t root_id, _position<SZ> const &rootBoard, int &node_expanded, int &iteration){
+	auto &arena = NODE<SZ>::arena;
+
+	// Step 1: SELECT
+	// - start from the root, top-down traverse according to the UCB scores
+	// - stop when meet terminal nodes or nodes not fully expanded yet
+	// - the board follows the path, node by node
+	uint32_t node = root_id;
+	_position<SZ> board = rootBoard;
+	int depthSofar = 0;
+	#ifdef transposition
+	// the owners on the way, the parents may lead elsewhere
+	uint32_t path[_board<SZ>::MAX_GAME_LENGTH+1];
+	path[0] = root_id;
+	#endif
+	while(board.state() == 0 && arena[node].fullExpanded()) {
+		// flog << "traverse...  " ;
+		uint32_t child = arena[node].getBestChild(node, board._turn);
+		#ifdef solver
+		if(child == NODE<SZ>::NIL) break; // a proof through an alias not seen here yet
+		#endif
+		node = NODE<SZ>::owner(child);
+		arena[node].prefetch();
+		board.apply_move(arena[child].getMove());
+		++depthSofar;
+		#ifdef transposition
+		path[depthSofar] = node;
+		#endif
+		// flog << "traversed." << std::endl;
+	}
 
-	srand(time(NULL));
-	// srand(1);
+	// Step 2: EXPAND
+	if(!arena[node].fullExpanded() && board.state() == 0 && arena[node].mayExpand()){
+		// flog << "expand" << std::endl;
+		node = arena[node].expandOneLeaf(node, board);
+		++node_expanded;
+		++depthSofar;
+		if (node == NODE<SZ>::NIL){
+			// flog << "\texpand failed" << std::endl;
+			exit(0);
+		}
+		node = NODE<SZ>::owner(node);
+		#ifdef transposition
+		path[depthSofar] = node;
+		#endif
+		// flog << "expanded." << std::endl;
+	}
 
-	do {
-		/* get initial positions */
-		for ( int i=0; i<2; ++i ) { for ( int j=0; j<NUM_CUBE; ++j ) {
-				init[i][j] = getchar();
-		}}
-		init[0][NUM_CUBE] = init[1][NUM_CUBE] = '\0';
-		start = getchar();
+	// Step 3: SIMULATE
+	// Step 4: BACK PROPAGATE
+	#ifdef transposition
+	iteration += arena[node].doSimulation(node, board, SIMULATION_BATCH, path, depthSofar);
+	#else
+	iteration += arena[node].doSimulation(node, board);
+	#endif
+
+	// Step 5: PROVE, the same way up
+	#ifdef solver
+	#ifdef transposition
+	for(int i=depthSofar; i>=0; --i) arena[path[i]].updateProof();
+	#else
+	for(uint32_t id=node; id!=NODE<SZ>::NIL; id=arena[id].parent) arena[id].updateProof();
+	#endif
+	#endif
+	return depthSofar;
+}
+#endif
 
-		flog << init[0] << " " << init[1] << std::endl;
-		flog << start << std::endl;
+#ifdef root_parallel
+// a root child's stats from one tree
+struct _ROOT_STAT {
+	uint8_t move;
+	int num_visits;
+	float value;
+	float sumOfSquaredValue;
+};
+
+// searches a tree of its own (this thread's arenas) until the clock runs
+// out, res gets the stats of the root's children
+template<int SZ> void rootParallelWorker(_position<SZ> rootBoard, typename NODE<SZ>::MOVE_BUFFER rootMoves, std::vector<_ROOT_STAT> &res, int &iteration){
+	auto &arena = NODE<SZ>::arena;
+	uint32_t root_id = NODE<SZ>::alloc();
+	arena[root_id].construct(root_id, NODE<SZ>::NIL, std::make_pair(15, 15));
+	arena[root_id].setMoves(rootMoves);
+	int node_expanded = 0;
+	iteration = 0;
+	while(!((MAX_SECOND > 0.0 && timer() >= MAX_SECOND) || (MAX_ITERATION > 0 && iteration >= MAX_ITERATION))){
+		#ifdef solver
+		if(arena[root_id].proven != 0) break;
+		#endif
+		searchOnce(root_id, rootBoard, node_expanded, iteration);
+	}
+	NODE<SZ> &root = arena[root_id];
+	for(int i=0; i<root.numExpanded; ++i){
+		uint32_t c = root.first_child+i;
+		res.push_back({arena[c].move, NODE<SZ>::num_visits[c], NODE<SZ>::value[c], NODE<SZ>::sumOfSquaredValue[c]});
+	}
+}
+#endif
 
-		/* game start s*/
-		b = new BOARD_GUI(init[0], init[1]);
-		b->no_hl = 1;
-		bool passed = false;
-		int myturnCounter = 0;
-
-		for ( myturn=(start=='f'); b->winner()==Color::OTHER; flip_bit(myturn) ) {
-			if ( myturn ) {
-
-				timer(true);
-				if(passed){
-					PII m = std::make_pair(15, 15);
-					// flog << "(PASSED) Turn: " << myturn << " | " << b->send_move(m) << std::endl;
-					b->do_move(m);
-					std::cout << b->send_move(m) << std::flush;
-					continue;
-				}
+// reads the opponent's move into num/dir, searching under played meanwhile
+// the reader thread takes exactly the two move chars, so undo (16) and the
+// restart handshake read by main() are left as they were
+template<int SZ> void ponderUntilMove(uint32_t played, _position<SZ> const &board){
+	if(played == NODE<SZ>::NIL){
+		num = getchar()-'0';
+		dir = getchar()-'0';
+		return;
+	}
+	std::atomic<bool> arrived(false);
+	int c[2];
+	std::thread reader([&](){
+		c[0] = getchar();
+		c[1] = getchar();
+		arrived = true;
+	});
+	timer(true);
+	int iteration = 0;
+	int node_expanded = 0;
+	while(!arrived){
+		#ifdef solver
+		if(NODE<SZ>::arena[played].proven != 0) break; // nothing left to search, wait for the move
+		#endif
+		searchOnce(played, board, node_expanded, iteration);
+	}
+	reader.join();
+	flog << "[Ponder] iter: " << iteration << ", seconds: " << timer() << std::endl;
+	num = c[0]-'0';
+	dir = c[1]-'0';
+}
 
-				auto ml = b->move_list();
-				if(ml.size() == 1){
-					// flog << "Meet the passed section!" << std::endl;
-					// flog << "passed" << std::endl;
-					if(ml.at(0) == std::make_pair(15, 15)){
-						passed = true;
+/* play one game on a SZ x SZ board */
+template<int SZ> void play () {
+	/* game start s*/
+	_board_gui<SZ> *b = new _board_gui<SZ>(init[0], init[1]);
+	b->no_hl = 1;
+	int myturnCounter = 0;
+	// the tree is kept across turns, played is the node of our last move and
+	// reuse the node after the opponent's reply, NIL = start from scratch
+	auto &arena = NODE<SZ>::arena;
+	uint32_t played = NODE<SZ>::NIL;
+	uint32_t reuse = NODE<SZ>::NIL;
+
+	for ( myturn=(start=='f'); b->winner()==Color::OTHER; flip_bit(myturn) ) {
+		if ( myturn ) {
+
+			timer(true);
+
+			auto ml = b->move_list();
+			if(ml.size() == 1){
+				// flog << "Meet the passed section!" << std::endl;
+				// flog << "passed" << std::endl;
+				PII m = ml.at(0);
+				// flog << "(PASSED) Turn: " << myturn << " | " << b->send_move(m) << std::endl;
+				b->do_move(m);
+				std::cout << b->send_move(m) << std::flush;
+				reuse = NODE<SZ>::NIL;
+				continue;
+			}
+			
+			// decide move
+			int iteration = 0;
+
+			// construct root node, or promote the subtree of the opponent's reply
+			uint32_t root_id;
+			bool reused = (reuse != NODE<SZ>::NIL && arena[reuse].first_child != NODE<SZ>::NIL);
+			if(reused){
+				root_id = NODE<SZ>::promote(reuse, *b);
+				flog << "Reused " << NODE<SZ>::num_visits[root_id] << " simulations, " << arena.size() << " nodes" << std::endl;
+			}else{
+				NODE<SZ>::reset();
+				root_id = NODE<SZ>::alloc();
+				arena[root_id].construct(root_id, NODE<SZ>::NIL, std::make_pair(15, 15));
+			}
+			reuse = NODE<SZ>::NIL;
+			NODE<SZ>* root = &arena[root_id];
+			_position<SZ> const rootBoard = *b;
+			typename NODE<SZ>::MOVE_BUFFER rootMoves;
+
+			// #ifdef pr
+			#ifdef sto
+			stochasticPrioritizeMovelist(rootBoard, rootMoves, false);
+			if(myturnCounter < 4){
+				typename NODE<SZ>::MOVE_BUFFER tmpQueue;
+				for(PII &move: rootMoves){
+					// flog << "yummy? " << rootBoard.yummy(move) << " [" << move.first << ", " << move.second << "] " << std::endl;
+					if(rootBoard.yummy(move) != -1){
+						tmpQueue.push_back(move);
 					}
-					PII m = ml.at(0);
-					// flog << "(PASSED) Turn: " << myturn << " | " << b->send_move(m) << std::endl;
-					b->do_move(m);
-					std::cout << b->send_move(m) << std::flush;
-					continue;
 				}
-				
-				// decide move
-				int iteration = 0;
-
-				// construct root node
-				NODE* root = new NODE;
-				root->construct(*b, NULL);
-
-				// #ifdef pr
-				#ifdef sto
-				root->moveToExpand = stochasticPrioritizeMovelist(root->board, false);
-				if(myturnCounter < 4){
-					std::queue<PII> tmpQueue;
-					for(PII &move = root->moveToExpand.front(); root->moveToExpand.size()>0; root->moveToExpand.pop(), move = root->moveToExpand.front()){
-						// flog << "yummy? " << root->board.yummy(move) << " [" << move.first << ", " << move.second << "] " << std::endl;
-						if(root->board.yummy(move) != -1){
-							tmpQueue.push(move);
-						}
+				rootMoves = tmpQueue;
+				// flog << "early game move size: " << rootMoves.size() << std::endl;
+			}
+			#else
+			prioritizeMovelist(rootBoard, rootMoves, false);
+			if(rootMoves.size() > 9){ // early game filter
+				typename NODE<SZ>::MOVE_BUFFER tmpQueue;
+				typename NODE<SZ>::MOVE_BUFFER tmpSelfeatQueue;
+				for(PII &move: rootMoves){
+					// flog << "yummy? " << rootBoard.yummy(move) << " [" << move.first << ", " << move.second << "] " << std::endl;
+					if(rootBoard.yummy(move) != -1){
+						tmpQueue.push_back(move);
+					}else{
+						tmpSelfeatQueue.push_back(move);
 					}
-					root->moveToExpand = tmpQueue;
-					// flog << "early game move size: " << root->moveToExpand.size() << std::endl;
 				}
-				#else
-				root->moveToExpand = prioritizeMovelist(root->board, false);
-				if(root->moveToExpand.size() > 9){ // early game filter
-					std::queue<PII> tmpQueue;
-					std::queue<PII> tmpSelfeatQueue;
-					for(PII &move = root->moveToExpand.front(); root->moveToExpand.size()>0; root->moveToExpand.pop(), move = root->moveToExpand.front()){
-						// flog << "yummy? " << root->board.yummy(move) << " [" << move.first << ", " << move.second << "] " << std::endl;
-						if(root->board.yummy(move) != -1){
-							tmpQueue.push(move);
-						}else{
-							tmpSelfeatQueue.push(move);
-						}
-					}
-					root->moveToExpand = tmpQueue;
-					if(root->moveToExpand.size() < 1){
-						root->moveToExpand = tmpSelfeatQueue;
-					}
-					// flog << "early game move size: " << root->moveToExpand.size() << std::endl;
+				rootMoves = tmpQueue;
+				if(rootMoves.size() < 1){
+					rootMoves = tmpSelfeatQueue;
+				}
+				// flog << "early game move size: " << rootMoves.size() << std::endl;
+			}
+			#endif
+			if(reused){
+				root->restrictMoves(rootMoves);
+			}else{
+				root->setMoves(rootMoves);
+			}
+			
+			flog << "\nGot " << rootMoves.size() << " moves to expand." << std::endl;
+			int max_depth = -1;
+			int node_expanded = 0;
+			#ifdef root_parallel
+			// NUM_THREADS-1 more trees on the same root, this thread is tree 0
+			std::vector<std::vector<_ROOT_STAT>> workerStats(NUM_THREADS-1);
+			std::vector<int> workerIteration(NUM_THREADS-1);
+			std::vector<std::thread> workers;
+			for(int t=0; t<NUM_THREADS-1; ++t){
+				workers.emplace_back(rootParallelWorker<SZ>, rootBoard, rootMoves, std::ref(workerStats[t]), std::ref(workerIteration[t]));
+			}
+			#endif
+			#ifdef tree_parallel
+			// MAX_ITERATION is per thread, as in root_parallel
+			iteration = treeParallelSearch(root_id, rootBoard, NUM_THREADS, MAX_SECOND, MAX_ITERATION*NUM_THREADS, node_expanded, max_depth);
+			flog << "[Turn " << b->turn_cnt << "] iter: " << iteration << ", seconds: " << timer() << ", threads: " << NUM_THREADS << std::endl;
+			flog << "\tmax depth: " << max_depth << ", num_nodes: " << node_expanded << ", arena: " << arena.size() << " x " << sizeof(NODE<SZ>) << " bytes" << std::endl;
+			#else
+			while(true){
+				// if(MAX_ITERATION > 0 && iteration >= MAX_ITERATION) break;
+				#ifdef solver
+				if(root->proven != 0){
+					std::lock_guard<std::mutex> lock(flog_mutex); // root_parallel trees may still be logging
+					flog << "[Turn " << b->turn_cnt << "] solved, " << ((root->proven < 0)? "win": "loss") << ", iter: " << iteration << ", seconds: " << timer() << std::endl;
+					break;
 				}
 				#endif
-				
-				flog << "\nGot " << root->moveToExpand.size() << " moves to expand." << std::endl;
-				int max_depth = -1;
-				int node_expanded = 0;
-				while(true){
-					// if(MAX_ITERATION > 0 && iteration >= MAX_ITERATION) break;
-					if((MAX_SECOND > 0.0 && timer() >= MAX_SECOND) || (MAX_ITERATION > 0 && iteration >= MAX_ITERATION)){
-						flog << "[Turn " << b->turn_cnt << "] iter: " << iteration << ", seconds: " << timer() << std::endl;
-						flog << "\tmax depth: " << max_depth << ", num_nodes: " << node_expanded << std::endl;
-						break;
-					}
-
-					// Step 1: SELECT
-					// - start from the root, top-down traverse according to the UCB scores
-					// - stop when meet terminal nodes or nodes not fully expanded yet
-					NODE* node = root;
-					int depthSofar = 0;
-					while(!node->isTerminal() && node->fullExpanded()) {
-						// flog << "traverse...  " ;
-                        node = node->getBestChild();
-						++depthSofar;
-						// flog << "traversed." << std::endl;
-					}
-
-					// Step 2: EXPAND
-					if(!node->fullExpanded() && !node->isTerminal()){
-						// flog << "expand" << std::endl;
-						node = node->expandOneLeaf();
-						++node_expanded;
-						++depthSofar;
-						if (node == NULL){
-							// flog << "\texpand failed" << std::endl;
-							exit(0);
-						}
-						// flog << "expanded." << std::endl;
-					}
-
-					if(depthSofar > max_depth)
-						max_depth = depthSofar;
-
-					// Step 3: SIMULATE
-					// Step 4: BACK PROPAGATE
-					node->doSimulation();
+				if((MAX_SECOND > 0.0 && timer() >= MAX_SECOND) || (MAX_ITERATION > 0 && iteration >= MAX_ITERATION)){
+					std::lock_guard<std::mutex> lock(flog_mutex); // root_parallel trees may still be logging
+					flog << "[Turn " << b->turn_cnt << "] iter: " << iteration << ", seconds: " << timer() << std::endl;
+					flog << "\tmax depth: " << max_depth << ", num_nodes: " << node_expanded << ", arena: " << arena.size() << " x " << sizeof(NODE<SZ>) << " bytes" << std::endl;
+					#ifdef transposition
+					flog << "\ttranspositions: " << NODE<SZ>::numTranspositions << std::endl;
+					#endif
+					#ifdef leaf_parallel
+					flog << "\tleaf batch: " << leafBatch.size << ", playout: " << leafBatch.latency*1e6 << " us, threads: " << NUM_THREADS << std::endl;
+					#endif
+					break;
+				}
 
-					iteration += SIMULATION_BATCH;
-					
+				int depthSofar = searchOnce(root_id, rootBoard, node_expanded, iteration);
+				if(depthSofar > max_depth)
+					max_depth = depthSofar;
+			}
+			#endif
+			#ifdef root_parallel
+			// merge the trees' root children into tree 0, the move is picked from the sums
+			// tree 0's own stats are put back after the pick, they have to match the
+			// subtrees kept for pondering and reuse
+			std::vector<uint32_t> ownIds;
+			std::vector<_ROOT_STAT> ownStats;
+			for(int i=0; i<root->numExpanded; ++i){
+				uint32_t c = NODE<SZ>::owner(root->first_child+i);
+				ownIds.push_back(c);
+				ownStats.push_back({arena[c].move, NODE<SZ>::num_visits[c], NODE<SZ>::value[c], NODE<SZ>::sumOfSquaredValue[c]});
+			}
+			for(int t=0; t<NUM_THREADS-1; ++t){
+				workers[t].join();
+				for(auto const &r: workerStats[t]){
+					uint32_t c = NODE<SZ>::owner(root->findChild(NODE<SZ>::unpack(r.move)));
+					if(c == NODE<SZ>::NIL) continue;
+					NODE<SZ>::num_visits[c] += r.num_visits;
+					NODE<SZ>::value[c] += r.value;
+					NODE<SZ>::sumOfSquaredValue[c] += r.sumOfSquaredValue;
 				}
+				iteration += workerIteration[t];
+			}
+			flog << "\t" << NUM_THREADS << " trees, iter: " << iteration << ", seconds: " << timer() << std::endl;
+			#endif
 
 
-				// auto ml = b->move_list();
-				// auto m = ml.at(rand()%ml.size());				
+			// auto ml = b->move_list();
+			// auto m = ml.at(rand()%ml.size());				
 
-				// flog << "Getting last and best move..." << std::endl;
-				
-				NODE* n = root->getBestChild(true);
-				PII m;
-				if(n){
-					m = n->board.getLastMove();
-				}else{
-					m = std::make_pair(15, 15);
-				}
+			// flog << "Getting last and best move..." << std::endl;
+			
+			uint32_t n = root->getBestChild(root_id, rootBoard._turn, true);
+			#ifdef root_parallel
+			for(size_t i=0; i<ownIds.size(); ++i){
+				NODE<SZ>::num_visits[ownIds[i]] = ownStats[i].num_visits;
+				NODE<SZ>::value[ownIds[i]] = ownStats[i].value;
+				NODE<SZ>::sumOfSquaredValue[ownIds[i]] = ownStats[i].sumOfSquaredValue;
+			}
+			#endif
+			PII m;
+			if(n != NODE<SZ>::NIL){
+				m = arena[n].getMove();
+			}else{
+				m = std::make_pair(15, 15);
+			}
 
-				// flog << "Turn: " << myturn << " | " << b->send_move(m) << std::endl;
-				b->do_move(m);
-				std::cout << b->send_move(m) << std::flush;
-				freeMemNode(root);
-				++myturnCounter;
-				// flog << "Time spent: " << timer() << std::endl;
+			// flog << "Turn: " << myturn << " | " << b->send_move(m) << std::endl;
+			b->do_move(m);
+			std::cout << b->send_move(m) << std::flush;
+			played = NODE<SZ>::owner(n);
+			++myturnCounter;
+			// flog << "Time spent: " << timer() << std::endl;
 
+		}
+		else {
+			#ifdef ponder
+			ponderUntilMove<SZ>(played, *b);
+			#else
+			num = getchar()-'0';
+			dir = getchar()-'0';
+			#endif
+			// flog << "Turn: " << myturn << " | " << (int)num << (int)dir << std::endl;
+			if ( num == 16 ) {
+				b->undo_move();
+				b->undo_move();
+				flip_bit(myturn);
+				reuse = NODE<SZ>::NIL;
 			}
 			else {
-				num = getchar()-'0';
-				dir = getchar()-'0';
-				// flog << "Turn: " << myturn << " | " << (int)num << (int)dir << std::endl;
-				if ( num == 16 ) {
-					b->undo_move();
-					b->undo_move();
-					flip_bit(myturn);
-				}
-				else {
-					b->do_move(num, dir);
+				b->do_move(num, dir);
+				if ( played != NODE<SZ>::NIL ) {
+					reuse = NODE<SZ>::owner(arena[played].findChild(std::make_pair(num, dir)));
 				}
 			}
+			played = NODE<SZ>::NIL;
 		}
-		flog << "winner: " << b->winner() << std::endl;
-		/* game end */
-		delete b;
+	}
+	flog << "winner: " << b->winner() << std::endl;
+	flog << "history:";
+	for ( auto const &m: b->history ) { flog << " " << m; }
+	flog << std::endl;
+	/* game end */
+	NODE<SZ>::reset();
+	delete b;
+}
+
+#ifdef scaling
+// tree_parallel scaling, one position searched for a fixed time on 1 ~ 32 threads
+template<int SZ> void scalingRun(std::string const &red, std::string const &blue, double seconds){
+	_position<SZ> const rootBoard = _board<SZ>(red, blue);
+	auto &arena = NODE<SZ>::arena;
+	double base = 0;
+	for(int threads=1; threads<=32; threads*=2){
+		NODE<SZ>::reset();
+		uint32_t root_id = NODE<SZ>::alloc();
+		arena[root_id].construct(root_id, NODE<SZ>::NIL, std::make_pair(15, 15));
+		typename NODE<SZ>::MOVE_BUFFER rootMoves;
+		prioritizeMovelist(rootBoard, rootMoves, false);
+		arena[root_id].setMoves(rootMoves);
+
+		int node_expanded = 0;
+		int max_depth = -1;
+		auto tick = std::chrono::steady_clock::now();
+		int iteration = treeParallelSearch(root_id, rootBoard, threads, seconds, 0, node_expanded, max_depth);
+		auto tock = std::chrono::steady_clock::now();
+		double sec = std::chrono::duration_cast<std::chrono::duration<double>>(tock-tick).count();
+		double rate = iteration/sec;
+		if(threads == 1) base = rate;
+		printf("%dx%d %2d threads: %9d simulations %6.2f s %10.0f sim/s speedup %5.2f, %d nodes, depth %d\n",
+			SZ, SZ, threads, iteration, sec, rate, rate/base, node_expanded, max_depth);
+	}
+	NODE<SZ>::reset();
+}
+
+// ./scaling [seconds per run]
+int main ( int argc, char **argv )
+{
+	logger(".log.progressive_scaling");
+	double seconds = (argc > 1)? atof(argv[1]): 2.0;
+	printf("%u hardware threads\n", std::thread::hardware_concurrency());
+	scalingRun<6>("013245", "542310", seconds);
+	scalingRun<7>("0136247589", "9857426310", seconds);
+	return (0);
+}
+#else
+int main () 
+{
+#ifdef sto
+	logger(".log.progressive_sto");
+#elif pr
+	logger(".log.progressive_pr");
+#elif ponder
+	logger(".log.progressive_ponder");
+#elif root_parallel
+	logger(".log.progressive_root_parallel");
+#elif tree_parallel
+	logger(".log.progressive_tree_parallel");
+#elif leaf_parallel
+	logger(".log.progressive_leaf_parallel");
+#elif transposition
+	logger(".log.progressive_transposition");
+#elif solver
+	logger(".log.progressive_solver");
+#elif refine
+	logger(".log.progressive_refine");
+#else
+	logger(".log.progressive");
+#endif
+	srand(time(NULL));
+	// srand(1);
+
+	do {
+		/* get initial positions */
+		int sz = read_init_position(init[0], init[1], start);
+
+		flog << init[0] << " " << init[1] << std::endl;
+		flog << start << std::endl;
+
+		if ( sz == 7 ) { play<7>(); }
+		else if ( sz == 6 ) { play<6>(); }
+		else { break; }
 	} while ( getchar()=='y' ); 
 
 	return (0);
-}
\ No newline at end of file
+}
+#endif
@@ -22,6 +22,7 @@
 #include <random>
 
 #include "einstein.hpp"
+#include "arena.hpp"
 
 const float UCB_C = sqrt(2);
 const int MAX_ITERATION = 10000; // 0: unlimited
@@ -29,8 +30,7 @@ const float MAX_SECOND = 10.0;
 const int SIMULATION_BATCH = 10;
 
 char start;
-char init[2][NUM_CUBE+1] = {};
-BOARD_GUI *b, tmp_b;
+std::string init[2];
 bool myturn;
 inline void flip_bit ( bool &_ ) { _ = !_; }
 char num, dir;
@@ -43,32 +43,27 @@ void logger ( std::string logfile ) {
 }
 using PII = std::pair<int, int>;
 
-typedef struct _POS{
-	int x;
-	int y;
-} POS;
+template<class BOARD_T> float simulation(BOARD_T b);
 
-float simulation(BOARD_GUI b);
-
-POS idxToPos(const int &idx){
-	POS newPOS;
-	newPOS.x = idx/BOARD_SZ;
-	newPOS.y = idx%BOARD_SZ;
-	return newPOS;
-}
-
-typedef struct _NODE{
+template<class BOARD_T> struct _NODE{
 	using ULL = unsigned long long;
 	using PII = std::pair<int, int>;
 	using PSS = std::pair<std::string, std::string>;
 	using VII = std::vector<PII>;
+	using MOVE_BUFFER = typename BOARD_T::MOVE_BUFFER;
+	static constexpr int MAX_MOVES = BOARD_T::MAX_MOVES;
 	
-	_NODE* parent;
+	using ARENA = _arena<_NODE>;
+	static constexpr uint32_t NIL = ARENA::NIL;
+	static ARENA arena; // every node of the tree, released at once by arena.reset()
+
+	uint32_t self, parent; // ids in arena
 	float value;
 	float sumOfSquaredValue;
 	int num_visits;
-	BOARD_GUI board;
-	std::vector<_NODE*> child;
+	BOARD_T board;
+	PII move; // the move from parent to here
+	std::vector<uint32_t> child;
 	VII moveToExpand;
 	VII movedList; // used for debug
 
@@ -78,7 +73,7 @@ typedef struct _NODE{
 		
 		if(child.size() == 1){
 			// flog << "Only one child" << std::endl;
-			return child[0];
+			return &arena[child[0]];
 		}
 
 		float bestUCB = -99999.0;
@@ -89,25 +84,25 @@ typedef struct _NODE{
 		// flog << "\tGetting best child..., child size: " << child.size() << std::endl;
 		if(decideMove){
 			for(int i=0; i<child.size(); ++i){
-				float winRate = (turn == 0)? (float)child[i]->value / (child[i]->num_visits) : -(float)child[i]->value / (child[i]->num_visits);
+				float winRate = (turn == 0)? (float)arena[child[i]].value / (arena[child[i]].num_visits) : -(float)arena[child[i]].value / (arena[child[i]].num_visits);
 
 				// flog << "\t\tUCT score: " << uct_score << std::endl;
 
 				if(winRate > bestUCB){
-					bestChild = child[i];
+					bestChild = &arena[child[i]];
 					bestUCB = winRate;
 				}
 			}
 		}else{
 			for(int i=0; i<child.size(); ++i){
-				float uct_exploitation = (turn == 0)? (float)child[i]->value / (child[i]->num_visits) : -(float)child[i]->value / (child[i]->num_visits);
-				float uct_exploration = sqrt( log((float)num_visits) / (child[i]->num_visits) );
+				float uct_exploitation = (turn == 0)? (float)arena[child[i]].value / (arena[child[i]].num_visits) : -(float)arena[child[i]].value / (arena[child[i]].num_visits);
+				float uct_exploration = sqrt( log((float)num_visits) / (arena[child[i]].num_visits) );
 				float uct_score = uct_exploitation + UCB_C * uct_exploration;
 
 				// flog << "\t\tUCT score: " << uct_score << std::endl;
 
 				if(uct_score > bestUCB){
-					bestChild = child[i];
+					bestChild = &arena[child[i]];
 					bestUCB = uct_score;
 				}
 			}
@@ -116,9 +111,12 @@ typedef struct _NODE{
 		return bestChild;
 	}
 
-	void construct(BOARD_GUI b, _NODE* p){
+	void construct(BOARD_T const &b, uint32_t id, uint32_t p){
 		board = b;
+		self = id;
 		parent = p;
+		child.clear();
+		movedList.clear();
 		num_visits = 0;
 		value = 0.0;
 		sumOfSquaredValue = 0.0;
@@ -126,9 +124,11 @@ typedef struct _NODE{
 
 	_NODE* addChildWithMove(PII &m){
 		// flog << "adding child... " << board.send_move(m) << std::endl;
-		_NODE* newNode = new _NODE;
+		uint32_t id = arena.alloc();
+		_NODE* newNode = &arena[id];
 		// flog << "adding child...0" << std::endl;
-		newNode->construct(board, this);
+		newNode->construct(board, id, self);
+		newNode->move = m;
 
 		// BOARD_GUI b_tmp = newNode->board;
 		// auto ml = b_tmp.move_list();
@@ -153,12 +153,12 @@ typedef struct _NODE{
 		// }
 
 		// flog << "adding child...1" << std::endl;
-		newNode->board.do_move(m);
+		newNode->board.apply_move(m);
 		newNode->moveToExpand = newNode->board.move_list();
 		auto rng = std::default_random_engine {};
 		std::shuffle(newNode->moveToExpand.begin(), newNode->moveToExpand.end(), rng);
 		// flog << "adding child...2" << std::endl;
-		child.push_back(newNode);
+		child.push_back(id);
 		// flog << "adding child...3" << std::endl;
 		return newNode;
 	}
@@ -167,8 +167,7 @@ typedef struct _NODE{
 		auto ml = board.move_list();
 		for(int i=0; i<ml.size(); ++i){
 			auto m = ml.at(i);
-			_NODE* newNode = addChildWithMove(m);
-			child.push_back(newNode);
+			addChildWithMove(m);
 		}
 	}
 
@@ -200,8 +199,8 @@ typedef struct _NODE{
 		}
 	}
 
-	_move getBestMove(){
-		return getBestChild()->board.history.back();
+	PII getBestMove(){
+		return getBestChild()->move;
 	}
 
 	void doSimulation(int batchSize = SIMULATION_BATCH){
@@ -218,7 +217,7 @@ typedef struct _NODE{
 		while(node){
 			node->num_visits += batchSize;
 			node->value += additionalSimVal;
-			node = node->parent;
+			node = (node->parent == NIL)? NULL: &arena[node->parent];
 		}
 
 		return;
@@ -233,30 +232,20 @@ typedef struct _NODE{
 	bool fullExpanded(){
 		return (moveToExpand.size() == 0);
 	}
-} NODE;
-
-void freeMemNode(NODE* root){
-	
-	if(root == NULL){
-		return;
-	}else{
-		for(int i=0; i<root->child.size(); ++i){
-			freeMemNode(root->child[i]);
-		}
-		delete root;
-	}
+};
+template<int SZ> using NODE = _NODE<_position<SZ>>;
 
-	return;
-}
+template<class BOARD_T> _arena<_NODE<BOARD_T>> _NODE<BOARD_T>::arena;
 
-float simulation(BOARD_GUI b){
+template<class BOARD_T> float simulation(BOARD_T b){
 	// bool turn = b._turn; // simulation i.t.o red/blue
 
+	typename BOARD_T::MOVE_BUFFER ml;
 	while(b.state() == 0){
 		// TODO some good random
-		auto ml = b.move_list();
-		auto m = ml.at(rand()%ml.size());
-		b.do_move(m);
+		b.generate_moves(ml);
+		auto m = ml[rand()%ml.size()];
+		b.apply_move(m);
 	}
 
 	// TODO some better eval
@@ -274,145 +263,143 @@ float simulation(BOARD_GUI b){
 	return res;
 }
 
-int main () 
-{
-
-	logger(".log.pure");
-
-	auto timer = [] ( bool reset = false ) -> double {
-		static decltype(std::chrono::steady_clock::now()) tick, tock;
-		if ( reset ) {
-			tick = std::chrono::steady_clock::now();
-			return (0);
-		}
-		tock = std::chrono::steady_clock::now();
-		return (std::chrono::duration_cast<std::chrono::duration<double>>(tock-tick).count());
-	};
+double timer ( bool reset = false ) {
+	static decltype(std::chrono::steady_clock::now()) tick, tock;
+	if ( reset ) {
+		tick = std::chrono::steady_clock::now();
+		return (0);
+	}
+	tock = std::chrono::steady_clock::now();
+	return (std::chrono::duration_cast<std::chrono::duration<double>>(tock-tick).count());
+}
 
-	// srand(time(NULL));
-	srand(1);
+/* play one game on a SZ x SZ board */
+template<int SZ> void play () {
+	/* game start s*/
+	_board_gui<SZ> *b = new _board_gui<SZ>(init[0], init[1]);
+	b->no_hl = 1;
 
-	do {
-		/* get initial positions */
-		for ( int i=0; i<2; ++i ) { for ( int j=0; j<NUM_CUBE; ++j ) {
-				init[i][j] = getchar();
-		}}
-		init[0][NUM_CUBE] = init[1][NUM_CUBE] = '\0';
-		start = getchar();
+	for ( myturn=(start=='f'); b->winner()==Color::OTHER; flip_bit(myturn) ) {
+		if ( myturn ) {
 
-		flog << init[0] << " " << init[1] << std::endl;
-		flog << start << std::endl;
+			timer(true);
 
-		/* game start s*/
-		b = new BOARD_GUI(init[0], init[1]);
-		b->no_hl = 1;
-		bool passed = false;
-
-		for ( myturn=(start=='f'); b->winner()==Color::OTHER; flip_bit(myturn) ) {
-			if ( myturn ) {
-
-				timer(true);
-				if(passed){
-					PII m = std::make_pair(15, 15);
-					// flog << "(PASSED) Turn: " << myturn << " | " << b->send_move(m) << std::endl;
-					b->do_move(m);
-					std::cout << b->send_move(m) << std::flush;
-					continue;
-				}
-
-				auto ml = b->move_list();
-				if(ml.size() == 1 && ml.at(0) == std::make_pair(15, 15)){
-					// flog << "Meet the passed section!" << std::endl;
-					// flog << "passed" << std::endl;
-					passed = true;
-					PII m = std::make_pair(15, 15);
-					// flog << "(PASSED) Turn: " << myturn << " | " << b->send_move(m) << std::endl;
-					b->do_move(m);
-					std::cout << b->send_move(m) << std::flush;
-					continue;
-				}
+			auto ml = b->move_list();
+			if(ml.size() == 1 && ml.at(0) == std::make_pair(15, 15)){
+				// flog << "Meet the passed section!" << std::endl;
+				// flog << "passed" << std::endl;
+				PII m = std::make_pair(15, 15);
+				// flog << "(PASSED) Turn: " << myturn << " | " << b->send_move(m) << std::endl;
+				b->do_move(m);
+				std::cout << b->send_move(m) << std::flush;
+				continue;
+			}
+			
+			// decide move
+			int iteration = 0;
+
+			// construct root node
+			auto &arena = NODE<SZ>::arena;
+			uint32_t root_id = arena.alloc();
+			NODE<SZ>* root = &arena[root_id];
+			root->construct(*b, root_id, NODE<SZ>::NIL);
+			root->moveToExpand = root->board.move_list();
+
+			while(true){
+				// flog << "iter: " << iteration << std::endl;
 				
-				// decide move
-				int iteration = 0;
-
-				// construct root node
-				NODE* root = new NODE;
-				root->construct(*b, NULL);
-				root->moveToExpand = root->board.move_list();
-
-				while(true){
-					// flog << "iter: " << iteration << std::endl;
-					
-					// Step 1: SELECT
-					// - start from the root, top-down traverse according to the UCB scores
-					// - stop when meet terminal nodes or nodes not fully expanded yet
-					NODE* node = root;
-					while(!node->isTerminal() && node->fullExpanded()) {
-						// flog << "traverse...  " ;
+				// Step 1: SELECT
+				// - start from the root, top-down traverse according to the UCB scores
+				// - stop when meet terminal nodes or nodes not fully expanded yet
+				NODE<SZ>* node = root;
+				while(!node->isTerminal() && node->fullExpanded()) {
+					// flog << "traverse...  " ;
                         node = node->getBestChild();
-						// flog << "traversed." << std::endl;
-					}
+					// flog << "traversed." << std::endl;
+				}
 
-					// Step 2: EXPAND
-					if(!node->fullExpanded() && !node->isTerminal()){
-						// flog << "expand" << std::endl;
-						node = node->expandOneLeaf();
-						if (node == NULL){
-							// flog << "\texpand failed" << std::endl;
-							exit(0);
-						}
-						// flog << "expanded." << std::endl;
+				// Step 2: EXPAND
+				if(!node->fullExpanded() && !node->isTerminal()){
+					// flog << "expand" << std::endl;
+					node = node->expandOneLeaf();
+					if (node == NULL){
+						// flog << "\texpand failed" << std::endl;
+						exit(0);
 					}
+					// flog << "expanded." << std::endl;
+				}
 
-					// Step 3: SIMULATE
-					// Step 4: BACK PROPAGATE
-					node->doSimulation();
+				// Step 3: SIMULATE
+				// Step 4: BACK PROPAGATE
+				node->doSimulation();
 
-					iteration += SIMULATION_BATCH;
-					if(MAX_ITERATION > 0 && iteration >= MAX_ITERATION) break;
-					if(MAX_SECOND > 0.0 && timer() >= MAX_SECOND) break;
-				}
+				iteration += SIMULATION_BATCH;
+				if(MAX_ITERATION > 0 && iteration >= MAX_ITERATION) break;
+				if(MAX_SECOND > 0.0 && timer() >= MAX_SECOND) break;
+			}
 
 
-				// auto ml = b->move_list();
-				// auto m = ml.at(rand()%ml.size());				
+			// auto ml = b->move_list();
+			// auto m = ml.at(rand()%ml.size());				
 
-				// flog << "Getting last and best move..." << std::endl;
-				
-				NODE* n = root->getBestChild(true);
-				PII m;
-				if(n){
-					m = n->board.getLastMove();
-				}else{
-					m = std::make_pair(15, 15);
-				}
+			// flog << "Getting last and best move..." << std::endl;
+			
+			NODE<SZ>* n = root->getBestChild(true);
+			PII m;
+			if(n){
+				m = n->move;
+			}else{
+				m = std::make_pair(15, 15);
+			}
 
-				flog << "Turn: " << myturn << " | " << b->send_move(m) << std::endl;
-				b->do_move(m);
-				std::cout << b->send_move(m) << std::flush;
-				freeMemNode(root);
+			flog << "Turn: " << myturn << " | " << b->send_move(m) << std::endl;
+			b->do_move(m);
+			std::cout << b->send_move(m) << std::flush;
+			arena.reset();
 
-				// flog << "Time spent: " << timer() << std::endl;
+			// flog << "Time spent: " << timer() << std::endl;
 
+		}
+		else {
+			num = getchar()-'0';
+			dir = getchar()-'0';
+			flog << "Turn: " << myturn << " | " << (int)num << (int)dir << std::endl;
+			if ( num == 16 ) {
+				b->undo_move();
+				b->undo_move();
+				flip_bit(myturn);
 			}
 			else {
-				num = getchar()-'0';
-				dir = getchar()-'0';
-				flog << "Turn: " << myturn << " | " << (int)num << (int)dir << std::endl;
-				if ( num == 16 ) {
-					b->undo_move();
-					b->undo_move();
-					flip_bit(myturn);
-				}
-				else {
-					b->do_move(num, dir);
-				}
+				b->do_move(num, dir);
 			}
 		}
-		flog << "winner: " << b->winner() << std::endl;
-		/* game end */
-		delete b;
+	}
+	flog << "winner: " << b->winner() << std::endl;
+	flog << "history:";
+	for ( auto const &m: b->history ) { flog << " " << m; }
+	flog << std::endl;
+	/* game end */
+	delete b;
+}
+
+int main () 
+{
+
+	logger(".log.pure");
+
+	srand(1);
+
+	do {
+		/* get initial positions */
+		int sz = read_init_position(init[0], init[1], start);
+
+		flog << init[0] << " " << init[1] << std::endl;
+		flog << start << std::endl;
+
+		if ( sz == 7 ) { play<7>(); }
+		else if ( sz == 6 ) { play<6>(); }
+		else { break; }
 	} while ( getchar()=='y' ); 
 
 	return (0);
-}
\ No newline at end of file
+}
@@ -0,0 +1,68 @@
+/*! \file ttable.hpp
+	\brief transposition table, position key -> node id
+	 fixed size, WAYS entries a bucket, a full bucket replaces the entry
+	 of least weight (the caller's measure, e.g. visits)
+	 clear() is O(1), entries of an older generation count as empty
+	\course Theory of Computer Game (TCG)
+*/
+#ifndef TTABLE_HPP
+#define TTABLE_HPP
+
+#include <cstdint>
+#include <vector>
+
+template<int BITS = 18, int WAYS = 4> struct _ttable {
+	static constexpr uint32_t NIL = UINT32_MAX;
+	static constexpr uint64_t SIZE = uint64_t(1)<<BITS;
+	static_assert(SIZE%WAYS == 0, "a bucket is WAYS entries");
+
+	struct _entry {
+		uint64_t key;
+		uint32_t id;
+		uint32_t gen; // 0: never used
+	};
+	std::vector<_entry> table;
+	uint32_t gen = 1;
+
+	_ttable () : table(SIZE, _entry{0, NIL, 0}) {}
+
+	// node of key, NIL if none
+	uint32_t find ( uint64_t key ) const noexcept {
+		_entry const *b = bucket(key);
+		for ( int i = 0; i < WAYS; ++i ) {
+			if ( b[i].gen == gen && b[i].key == key ) { return (b[i].id); }
+		}
+		return (NIL);
+	}
+	// weight(id) of the entries in key's bucket picks the one to replace
+	template<class W> void insert ( uint64_t key, uint32_t id, W weight ) {
+		_entry *b = bucket(key);
+		_entry *victim = nullptr;
+		for ( int i = 0; i < WAYS; ++i ) {
+			if ( b[i].gen != gen || b[i].key == key ) {
+				victim = &b[i];
+				break;
+			}
+			if ( victim == nullptr || weight(b[i].id) < weight(victim->id) ) {
+				victim = &b[i];
+			}
+		}
+		*victim = _entry{key, id, gen};
+	}
+	void clear () {
+		if ( ++gen == 0 ) { // wrapped, the old generations could match again
+			for ( auto &e: table ) { e.gen = 0; }
+			gen = 1;
+		}
+	}
+
+private:
+	_entry *bucket ( uint64_t key ) noexcept {
+		return (&table[(key&(SIZE/WAYS-1))*WAYS]);
+	}
+	_entry const *bucket ( uint64_t key ) const noexcept {
+		return (&table[(key&(SIZE/WAYS-1))*WAYS]);
+	}
+};
+
+#endif
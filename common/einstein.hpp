@@ -0,0 +1,1072 @@
+// Copyright (C) 2019 Yueh-Ting Chen (eopXD)
+/*! \file einstein.hpp
+	\brief structures of the game, you may want to know the APIs
+	\author Yueh-Ting Chen (eopXD)
+	\course Theory of Computer Game (TCG)
+*/
+#ifndef EINSTEIN_HPP
+#define EINSTEIN_HPP
+
+// C++
+#include <cstdio>
+#include <cstdint>
+#include <cassert>
+// std::
+#include <iostream> // cin, cout, cerr
+#include <fstream>
+#include <string>
+#include <array>
+#include <vector>
+#include <random> // default_random_engine
+#include <chrono> // system_clock
+#include <algorithm> // shuffle
+#include <stdexcept> // runtime_error
+#include <type_traits> // is_trivially_copyable
+
+extern std::fstream flog;
+
+/* Color */
+enum class Color { R, B, OTHER, NO_ONE };
+// cast a scoped enum to its underlying type
+template<typename E> typename std::underlying_type<E>::type constexpr enum2int ( E enumerator ) noexcept {
+    return (static_cast<typename std::underlying_type<E>::type>(enumerator));
+}
+std::ostream &operator << ( std::ostream &os, Color const &c ) {
+    return (os << "rb_x"[enum2int(c)]);
+}
+
+/* Cube */
+
+const int NO_CUBE = 10; // num of no cube, above every cube of 6x6 and 7x7
+
+struct _cube {
+	Color c = Color::OTHER;
+	int num = NO_CUBE;
+	_cube () noexcept = default;
+	_cube ( Color _c, int _num=0 ) noexcept {
+		c = _c;
+		num = _num;
+	}
+	_cube &operator = ( _cube const &cube ) {
+		c = cube.c;
+		num = cube.num;
+		return (*this);
+
+	}
+	explicit operator bool () const noexcept {
+		return (num==NO_CUBE or c==Color::OTHER);
+	}
+	bool operator == ( _cube const &rhs ) const noexcept {
+		return (c==rhs.c and num==rhs.num);
+	}
+	bool operator == ( _cube *const &rhs ) const noexcept {
+		return (c==rhs->c and num==rhs->num);
+	}
+	bool operator != ( _cube const &rhs ) const noexcept {
+		return (c!=rhs.c or num!=rhs.num);
+	}
+};
+using CUBE = _cube;
+std::ostream &operator << ( std::ostream &os, CUBE const &c ) {
+	if ( c.c == Color::OTHER ) { return (os << "--"); }
+	os << c.c;
+	if ( c.num == NO_CUBE ) { return (os << "--"); }
+	else { return (os << c.num); }
+}
+
+// a bitboard keeps one bit per square, both 6x6 and 7x7 fit in 64 bits
+using BITBOARD = uint64_t;
+const int CAPTURED = -1; // square index of a cube that has been eaten
+
+const int NUM_PLAYER = 2;
+const int R_PLAYER = 0;
+const int B_PLAYER = 1;
+
+/* Board geometry */
+// everything that differs between the 6x6 and 7x7 variants
+template<int SZ> struct _board_traits;
+template<> struct _board_traits<6> {
+	static constexpr int BOARD_SZ = 6;
+	static constexpr int NUM_POSITION = 36;
+	static constexpr int NUM_CUBE = 6;
+	static constexpr int R_CORNER = 0;
+	static constexpr int B_CORNER = 35;
+	static constexpr bool PARITY_RULE = false; // allow to move any piece
+	static constexpr bool ROTATION_SYMMETRY = true; // see canonical_key()
+	static constexpr int MAX_MOVES = 18; // 6 cubes x 3 directions
+	// 6x6 initial position
+	static constexpr int init_cube_pos[2][NUM_CUBE] = {
+		{ 0,  1,  2,  6,  7, 12},
+		{23, 28, 29, 33, 34, 35}};
+	static constexpr int init_cube[2][NUM_CUBE] = {
+		{ 0,  1,  3,  2,  4,  5},
+		{ 5,  4,  2,  3,  1,  0}};
+};
+template<> struct _board_traits<7> {
+	static constexpr int BOARD_SZ = 7;
+	static constexpr int NUM_POSITION = 49;
+	static constexpr int NUM_CUBE = 10;
+	static constexpr int R_CORNER = 0;
+	static constexpr int B_CORNER = 48;
+	static constexpr bool PARITY_RULE = true; // move odd/even on odd/even turns
+	// R and B move the same parity in a turn, so R/B swapped is not the same game
+	static constexpr bool ROTATION_SYMMETRY = false;
+	static constexpr int MAX_MOVES = 15; // 5 odd/even cubes x 3 directions
+	// 7x7 initial positions
+	static constexpr int init_cube_pos[2][NUM_CUBE] = {
+		{ 0,  1,  2,  3,  7,  8,  9, 14, 15, 21}, 
+		{27, 33, 34, 39, 40, 41, 45, 46, 47, 48}};
+	static constexpr int init_cube[2][NUM_CUBE] = {
+		{ 0,  1,  3,  6,  2,  4,  7,  5,  8,  9},
+		{ 9,  8,  5,  7,  4,  2,  6,  3,  1 , 0}};
+};
+
+// variant chosen by -D SEVEN, for code playing only one of them
+#ifdef SEVEN
+const int BOARD_SZ = 7; // 7x7
+#else
+const int BOARD_SZ = 6;
+#endif
+const int NUM_POSITION = _board_traits<BOARD_SZ>::NUM_POSITION;
+const int NUM_CUBE = _board_traits<BOARD_SZ>::NUM_CUBE;
+const int R_CORNER = _board_traits<BOARD_SZ>::R_CORNER;
+const int B_CORNER = _board_traits<BOARD_SZ>::B_CORNER;
+const int MAX_MOVES = _board_traits<BOARD_SZ>::MAX_MOVES;
+
+// [0] = Player0, [1] = Player1
+constexpr int dx[2][3] = {{1, 0, 1}, {-1, 0, -1}};
+constexpr int dy[2][3] = {{0, 1, 1}, {0, -1, -1}};
+
+/* Move tables */
+// everything dx/dy and out() would compute, resolved at compile time
+template<int SZ> struct _move_table {
+	static constexpr int NUM_POS = SZ*SZ;
+
+	int8_t row[NUM_POS], col[NUM_POS]; // pos/SZ, pos%SZ
+	int8_t transpose[NUM_POS]; // pos mirrored on the main diagonal
+	int8_t to[NUM_PLAYER][NUM_POS][3]; // destination of (player, pos, dir), -1 if out
+	BITBOARD to_mask[NUM_PLAYER][NUM_POS]; // all destinations of (player, pos)
+	BITBOARD from_mask[NUM_PLAYER][NUM_POS]; // all squares player reaches pos from
+	// destination list of (player, pos), only the directions staying on board
+	int8_t num_dest[NUM_PLAYER][NUM_POS];
+	int8_t dest_dir[NUM_PLAYER][NUM_POS][3];
+	int8_t dest_pos[NUM_PLAYER][NUM_POS][3];
+
+	constexpr _move_table () : row(), col(), transpose(), to(), to_mask(), 
+	 from_mask(), num_dest(), dest_dir(), dest_pos() {
+		for ( int pos=0; pos<NUM_POS; ++pos ) {
+			row[pos] = pos/SZ;
+			col[pos] = pos%SZ;
+			transpose[pos] = (pos%SZ)*SZ+pos/SZ;
+			for ( int ply=0; ply<NUM_PLAYER; ++ply ) {
+				for ( int dir=0; dir<3; ++dir ) {
+					int xx = pos/SZ+dx[ply][dir];
+					int yy = pos%SZ+dy[ply][dir];
+					if ( xx<0 or yy<0 or xx>=SZ or yy>=SZ ) {
+						to[ply][pos][dir] = -1;
+						continue;
+					}
+					int k = num_dest[ply][pos]++;
+					to[ply][pos][dir] = xx*SZ+yy;
+					to_mask[ply][pos] |= BITBOARD(1)<<(xx*SZ+yy);
+					from_mask[ply][xx*SZ+yy] |= BITBOARD(1)<<pos;
+					dest_dir[ply][pos][k] = dir;
+					dest_pos[ply][pos][k] = xx*SZ+yy;
+				}
+			}
+		}
+	}
+};
+template<int SZ> constexpr _move_table<SZ> MOVE_TABLE_OF{};
+constexpr _move_table<BOARD_SZ> const &MOVE_TABLE = MOVE_TABLE_OF<BOARD_SZ>;
+
+/* Symmetries */
+// both variants are the same game mirrored on the main diagonal (dir 0 <-> 1),
+// 6x6 also rotated 180 degrees with R/B swapped (side to move swaps too)
+const int SYM_TRANSPOSE = 1;
+const int SYM_ROTATE = 2;
+
+/* Zobrist keys */
+// splitmix64, keys are the same in every build so hashes can be stored
+constexpr uint64_t splitmix64 ( uint64_t x ) noexcept {
+	x += 0x9e3779b97f4a7c15ULL;
+	x = (x^(x>>30))*0xbf58476d1ce4e5b9ULL;
+	x = (x^(x>>27))*0x94d049bb133111ebULL;
+	return (x^(x>>31));
+}
+template<int SZ> struct _zobrist_table {
+	static constexpr int NUM_CUBE = _board_traits<SZ>::NUM_CUBE;
+	static constexpr int NUM_POS = SZ*SZ;
+
+	uint64_t cube[NUM_PLAYER][NUM_CUBE][NUM_POS]; // (player, num) on pos
+	uint64_t turn; // B to move
+	uint64_t parity; // even turn_cnt, only 7x7 moves depend on it
+
+	constexpr _zobrist_table () : cube(), turn(), parity() {
+		uint64_t seed = 0;
+		for ( int ply=0; ply<NUM_PLAYER; ++ply ) {
+			for ( int num=0; num<NUM_CUBE; ++num ) {
+				for ( int pos=0; pos<NUM_POS; ++pos ) {
+					cube[ply][num][pos] = splitmix64(seed++);
+				}
+			}
+		}
+		turn = splitmix64(seed++);
+		parity = splitmix64(seed++);
+	}
+};
+template<int SZ> constexpr _zobrist_table<SZ> ZOBRIST_OF{};
+constexpr _zobrist_table<BOARD_SZ> const &ZOBRIST = ZOBRIST_OF<BOARD_SZ>;
+
+template<int SZ> struct _square {
+	static constexpr int NUM_POSITION = SZ*SZ;
+
+	int pos = NUM_POSITION;
+	_square () noexcept = default;
+	_square ( int const &x, int const &y ) noexcept {
+		pos = x*SZ+y;
+	}
+	bool operator == ( _square const &rhs ) const noexcept {
+		return (pos==rhs.pos);
+	}
+
+	explicit operator bool () const noexcept {
+		return (pos != NUM_POSITION);
+	}
+	int x () const noexcept { return (MOVE_TABLE_OF<SZ>.row[pos]); }
+	int y () const noexcept { return (MOVE_TABLE_OF<SZ>.col[pos]); }
+};
+using SQUARE = _square<BOARD_SZ>; 
+template<int SZ> std::ostream &operator << ( std::ostream &os, _square<SZ> const &sq ) {
+	if ( sq ) {
+		return (os << "(" << sq.x() << ", " << sq.y() << ")");
+	}
+	else {
+		return (os << "(X, X)");
+	}
+}
+
+/* need move structure to record history */
+// 16 bits, everything undo needs, also written to logs as 4 hex digits
+// bit 0~5 start square, 6~7 direction, 8 eat, 9 eaten color,
+// bit 10~13 eaten number, 14 whose move, 15 pass
+const int MOVE_DIR_SHIFT = 6;
+const int MOVE_EAT_SHIFT = 8;
+const int MOVE_EATEN_C_SHIFT = 9;
+const int MOVE_EATEN_NUM_SHIFT = 10;
+const int MOVE_WHO_SHIFT = 14;
+const int MOVE_PASS_SHIFT = 15;
+struct _move {
+	uint16_t bits = 0;
+	
+	_move () noexcept = default;
+	explicit _move ( uint16_t const &_bits ) noexcept : bits(_bits) {}
+	_move ( Color who, int _s, int _dir, int _eat=0, CUBE _c=CUBE() ) noexcept {
+		bits = _s|(_dir<<MOVE_DIR_SHIFT)|(enum2int(who)<<MOVE_WHO_SHIFT);
+		if ( _eat ) {
+			bits |= (1<<MOVE_EAT_SHIFT)|(enum2int(_c.c)<<MOVE_EATEN_C_SHIFT)
+			 |(_c.num<<MOVE_EATEN_NUM_SHIFT);
+		}
+	}
+	_move ( Color who ) noexcept {
+		bits = (enum2int(who)<<MOVE_WHO_SHIFT)|(1<<MOVE_PASS_SHIFT);
+	}
+	bool operator == ( _move const &rhs ) const noexcept { return (bits==rhs.bits); }
+	bool operator != ( _move const &rhs ) const noexcept { return (bits!=rhs.bits); }
+
+	// who moved this move
+	Color whose_move () const noexcept { return (static_cast<Color>((bits>>MOVE_WHO_SHIFT)&1)); }
+	// encoded position - [0 ~ (NUM_POS-1)], end square is MOVE_TABLE.to[ply][start][dir]
+	int start_pos () const noexcept { return (bits&63); }
+	int dir () const noexcept { return ((bits>>MOVE_DIR_SHIFT)&3); }
+	bool eat_cube () const noexcept { return ((bits>>MOVE_EAT_SHIFT)&1); }
+	// the eaten cube, valid when eat_cube() = 1
+	CUBE c () const noexcept {
+		return (CUBE(static_cast<Color>((bits>>MOVE_EATEN_C_SHIFT)&1), 
+			(bits>>MOVE_EATEN_NUM_SHIFT)&15));
+	}
+	bool pass () const noexcept { return ((bits>>MOVE_PASS_SHIFT)&1); } // whether it passed the turn or not
+};
+using MOVE = _move;
+static_assert(sizeof(MOVE) == 2, "MOVE should stay 16 bits");
+std::ostream &operator << ( std::ostream &os, MOVE const &m ) {
+	char buf[5];
+	snprintf(buf, sizeof(buf), "%04x", (unsigned)m.bits);
+	return (os << buf);
+}
+
+/* fixed-capacity undo stack, copied as a flat array */
+template<int CAP> struct _move_stack {
+	MOVE moves[CAP];
+	int sz = 0;
+
+	void clear () noexcept { sz = 0; }
+	int size () const noexcept { return (sz); }
+	bool empty () const noexcept { return (sz == 0); }
+	void push_back ( MOVE const &m ) noexcept {
+		assert(sz < CAP);
+		moves[sz++] = m;
+	}
+	template<class... ARGS> void emplace_back ( ARGS const &...args ) noexcept {
+		push_back(MOVE(args...));
+	}
+	void pop_back () noexcept { --sz; }
+	MOVE const &back () const noexcept { return (moves[sz-1]); }
+	MOVE const &operator [] ( int const &i ) const noexcept { return (moves[i]); }
+	MOVE const *begin () const noexcept { return (moves); }
+	MOVE const *end () const noexcept { return (moves+sz); }
+};
+
+/* fixed-capacity move list living on the stack, no heap allocation */
+template<int MAX_MOVES> struct _move_buffer {
+	using PII = std::pair<int, int>;
+
+	PII moves[MAX_MOVES];
+	int sz = 0;
+
+	void clear () noexcept { sz = 0; }
+	int size () const noexcept { return (sz); }
+	bool empty () const noexcept { return (sz == 0); }
+	void push_back ( PII const &m ) noexcept {
+		assert(sz < MAX_MOVES);
+		moves[sz++] = m;
+	}
+	void emplace_back ( int const &num, int const &dir ) noexcept {
+		push_back(std::make_pair(num, dir));
+	}
+	PII &operator [] ( int const &i ) noexcept { return (moves[i]); }
+	PII const &operator [] ( int const &i ) const noexcept { return (moves[i]); }
+	PII *begin () noexcept { return (moves); }
+	PII *end () noexcept { return (moves+sz); }
+	PII const *begin () const noexcept { return (moves); }
+	PII const *end () const noexcept { return (moves+sz); }
+};
+using MOVE_BUFFER = _move_buffer<MAX_MOVES>;
+
+/* Packed position */
+// canonical 128-bit form of a position, for tables, books, logs and snapshots
+// 6 bits per cube (square, PACKED_CAPTURED if eaten), cube i = ply*NUM_CUBE+num
+// lo holds cubes 0~9, hi holds cubes 10~19, bit 62/63 of hi = B to move/even turn
+const int PACKED_CUBE_BITS = 6;
+const int PACKED_CUBES_PER_WORD = 10;
+const uint64_t PACKED_CAPTURED = 63;
+const int PACKED_TURN_BIT = 62;
+const int PACKED_PARITY_BIT = 63;
+struct _packed_position {
+	uint64_t lo = 0, hi = 0;
+
+	bool operator == ( _packed_position const &rhs ) const noexcept {
+		return (lo==rhs.lo and hi==rhs.hi);
+	}
+	bool operator != ( _packed_position const &rhs ) const noexcept {
+		return (lo!=rhs.lo or hi!=rhs.hi);
+	}
+	bool operator < ( _packed_position const &rhs ) const noexcept {
+		return (hi<rhs.hi or (hi==rhs.hi and lo<rhs.lo));
+	}
+	// square of the i-th cube, PACKED_CAPTURED if eaten
+	int cube ( int const &i ) const noexcept {
+		uint64_t const &word = (i<PACKED_CUBES_PER_WORD)? lo: hi;
+		return ((word>>(PACKED_CUBE_BITS*(i%PACKED_CUBES_PER_WORD)))&PACKED_CAPTURED);
+	}
+	void set_cube ( int const &i, uint64_t const &pos ) noexcept {
+		uint64_t &word = (i<PACKED_CUBES_PER_WORD)? lo: hi;
+		word |= pos<<(PACKED_CUBE_BITS*(i%PACKED_CUBES_PER_WORD));
+	}
+	bool turn () const noexcept { return ((hi>>PACKED_TURN_BIT)&1); }
+	bool even_turn () const noexcept { return ((hi>>PACKED_PARITY_BIT)&1); }
+};
+using PACKED = _packed_position;
+std::ostream &operator << ( std::ostream &os, PACKED const &p ) {
+	char buf[33];
+	snprintf(buf, sizeof(buf), "%016llx%016llx", 
+		(unsigned long long)p.hi, (unsigned long long)p.lo);
+	return (os << buf);
+}
+namespace std {
+template<> struct hash<PACKED> {
+	size_t operator () ( PACKED const &p ) const noexcept {
+		return (splitmix64(p.lo^splitmix64(p.hi)));
+	}
+};
+}
+/* Position */
+// everything search needs and nothing else, trivially copyable
+// _board adds the initial setup and the history on top of it
+template<int SZ> struct _position {
+	using ULL = unsigned long long;
+	using PII = std::pair<int, int>;
+	using PSS = std::pair<std::string, std::string>;
+	using VII = std::vector<PII>;
+
+	using TRAITS = _board_traits<SZ>;
+	static constexpr int BOARD_SZ = TRAITS::BOARD_SZ;
+	static constexpr int NUM_POSITION = TRAITS::NUM_POSITION;
+	static constexpr int NUM_CUBE = TRAITS::NUM_CUBE;
+	static constexpr int R_CORNER = TRAITS::R_CORNER;
+	static constexpr int B_CORNER = TRAITS::B_CORNER;
+	static constexpr int MAX_MOVES = TRAITS::MAX_MOVES;
+	using MOVE_BUFFER = _move_buffer<MAX_MOVES>;
+	using SQUARE = _square<SZ>;
+	static constexpr _move_table<SZ> const &MOVE_TABLE = MOVE_TABLE_OF<SZ>;
+	static constexpr _zobrist_table<SZ> const &ZOBRIST = ZOBRIST_OF<SZ>;
+	static_assert(NUM_PLAYER*NUM_CUBE <= 2*PACKED_CUBES_PER_WORD, "too many cubes to pack");
+	static_assert(NUM_POSITION < PACKED_CAPTURED, "too many squares to pack");
+
+	BITBOARD occupied[NUM_PLAYER] = {}; // R/B, one bit per square
+	int8_t position[NUM_PLAYER][NUM_CUBE]; // R/B, number -> square (or CAPTURED)
+	
+	Color _winner = Color::OTHER; // OTHER = game winner not determined
+	int status = 0; // state(), kept up to date by every move
+	bool _turn = 0; // R moves first
+	int turn_cnt = 1; // odd/even turn move odd/even pieces(start from odd)
+	int num_cubes[2] = {NUM_CUBE, NUM_CUBE}; // both start with num_cubes cubes
+	uint64_t key = 0; // zobrist key, kept up to date by every move
+
+	PACKED pack () const noexcept {
+		PACKED res;
+		for ( int ply=0; ply<NUM_PLAYER; ++ply ) {
+			for ( int num=0; num<NUM_CUBE; ++num ) {
+				int pos = position[ply][num];
+				res.set_cube(ply*NUM_CUBE+num, (pos==CAPTURED)? PACKED_CAPTURED: pos);
+			}
+		}
+		res.hi |= uint64_t(_turn)<<PACKED_TURN_BIT;
+		res.hi |= uint64_t(turn_cnt%2 == 0)<<PACKED_PARITY_BIT;
+		return (res);
+	}
+	// restores the position, turn_cnt is only kept up to its parity (1 or 2)
+	void unpack ( PACKED const &p ) noexcept {
+		occupied[R_PLAYER] = occupied[B_PLAYER] = 0;
+		num_cubes[R_PLAYER] = num_cubes[B_PLAYER] = 0;
+		key = 0;
+		for ( int ply=0; ply<NUM_PLAYER; ++ply ) {
+			for ( int num=0; num<NUM_CUBE; ++num ) {
+				int pos = p.cube(ply*NUM_CUBE+num);
+				if ( pos == PACKED_CAPTURED ) {
+					position[ply][num] = CAPTURED;
+					continue;
+				}
+				place(ply, num, pos);
+				++num_cubes[ply];
+			}
+		}
+		_turn = p.turn();
+		turn_cnt = p.even_turn()? 2: 1;
+		if ( _turn ) { key ^= ZOBRIST.turn; }
+		if ( TRAITS::PARITY_RULE and p.even_turn() ) { key ^= ZOBRIST.parity; }
+		update_game(compute_state());
+	}
+	void printPos(){
+		for(int i=0; i<2; ++i){
+			flog << "player: " << i << ": ";
+			for(int j=0; j<NUM_CUBE; ++j){
+				PII pos = find(static_cast<Color>(i), j);
+				flog << "[" << pos.first << ", " << pos.second << "] ";
+			}
+			flog << std::endl;
+		}
+	}
+
+	Color turn () const noexcept { return (static_cast<Color>(_turn)); }
+	Color winner () const noexcept { return (_winner); }
+	void next_turn () noexcept {
+		if ( TRAITS::PARITY_RULE and _turn ) { key ^= ZOBRIST.parity; }
+		turn_cnt += _turn; _turn = !_turn;
+		key ^= ZOBRIST.turn;
+	}
+	void prev_turn () noexcept {
+		_turn = !_turn; turn_cnt -= _turn;
+		key ^= ZOBRIST.turn;
+		if ( TRAITS::PARITY_RULE and _turn ) { key ^= ZOBRIST.parity; }
+	}
+	// zobrist key from scratch, equals key at all times
+	uint64_t compute_key () const noexcept {
+		uint64_t res = 0;
+		for ( int ply=0; ply<NUM_PLAYER; ++ply ) {
+			for ( int num=0; num<NUM_CUBE; ++num ) {
+				if ( position[ply][num] != CAPTURED ) {
+					res ^= ZOBRIST.cube[ply][num][position[ply][num]];
+				}
+			}
+		}
+		if ( _turn ) { res ^= ZOBRIST.turn; }
+		if ( TRAITS::PARITY_RULE and turn_cnt%2 == 0 ) { res ^= ZOBRIST.parity; }
+		return (res);
+	}
+	// one key for all symmetric copies of the position, for tables and books
+	// B to move is rotated to R to move where the rotation holds (6x6), then
+	// the smaller key of it and its transpose is taken
+	// sym gets the SYM_* applied: moves map dir 0 <-> 1 under SYM_TRANSPOSE,
+	// and results are from the other color's view under SYM_ROTATE
+	uint64_t canonical_key ( int *sym=nullptr ) const noexcept {
+		bool rotate = TRAITS::ROTATION_SYMMETRY and _turn;
+		uint64_t plain = 0, mirror = 0;
+		for ( int ply=0; ply<NUM_PLAYER; ++ply ) {
+			for ( int num=0; num<NUM_CUBE; ++num ) {
+				int pos = position[ply][num];
+				if ( pos == CAPTURED ) {
+					continue;
+				}
+				int c_ply = rotate? !ply: ply;
+				int c_pos = rotate? NUM_POSITION-1-pos: pos;
+				plain ^= ZOBRIST.cube[c_ply][num][c_pos];
+				mirror ^= ZOBRIST.cube[c_ply][num][MOVE_TABLE.transpose[c_pos]];
+			}
+		}
+		uint64_t rest = 0;
+		if ( _turn and !rotate ) { rest ^= ZOBRIST.turn; }
+		if ( TRAITS::PARITY_RULE and turn_cnt%2 == 0 ) { rest ^= ZOBRIST.parity; }
+		plain ^= rest, mirror ^= rest;
+		int applied = rotate? SYM_ROTATE: 0;
+		if ( mirror < plain ) {
+			plain = mirror;
+			applied |= SYM_TRANSPOSE;
+		}
+		if ( sym != nullptr ) { *sym = applied; }
+		return (plain);
+	}
+
+	static BITBOARD bit ( int const &pos ) noexcept {
+		return (BITBOARD(1)<<pos);
+	}
+	void place ( int const &ply, int const &num, int const &pos ) noexcept {
+		position[ply][num] = pos;
+		occupied[ply] |= bit(pos);
+		key ^= ZOBRIST.cube[ply][num][pos];
+	}
+	// number of the cube of player ply standing on pos, NUM_CUBE if none
+	int cube_on ( int const &ply, int const &pos ) const noexcept {
+		if ( !(occupied[ply]&bit(pos)) ) {
+			return (NUM_CUBE);
+		}
+		int num = 0;
+		while ( position[ply][num] != pos ) {
+			++num;
+		}
+		return (num);
+	}
+	// cube standing on pos, CUBE() if the square is empty
+	CUBE cube_at ( int const &pos ) const noexcept {
+		for ( int ply=0; ply<NUM_PLAYER; ++ply ) {
+			if ( occupied[ply]&bit(pos) ) {
+				return (CUBE(static_cast<Color>(ply), cube_on(ply, pos)));
+			}
+		}
+		return (CUBE());
+	}
+
+	bool out ( int const &x, int const &y ) const noexcept {
+		return (x<0 or y<0 or x>=BOARD_SZ or y>=BOARD_SZ);
+	}
+	bool occupy ( int const &x, int const &y ) const noexcept {
+		return ((occupied[R_PLAYER]|occupied[B_PLAYER])&bit(x*BOARD_SZ+y));
+	}
+	// 0 = not over
+	// 1 = player R wins, 2 = player B wins, 3 = draw
+	int state () const noexcept { return (status); }
+	// state from scratch, equals status at all times
+	int compute_state () const noexcept {
+		if ( num_cubes[1] == 0 ) { return (1); }
+		if ( num_cubes[0] == 0 ) { return (2); }
+		if ( (occupied[B_PLAYER]&bit(R_CORNER)) and (occupied[R_PLAYER]&bit(B_CORNER)) ) {
+			int b_num = cube_on(B_PLAYER, R_CORNER);
+			int r_num = cube_on(R_PLAYER, B_CORNER);
+			if ( b_num < r_num ) {
+				return (2);
+			}
+			else if ( b_num > r_num ) {
+				return (1);
+			}
+			else {
+				return (3);
+			}
+		}
+		return (0);
+	}
+	void update_game ( int game_status ) noexcept {
+		status = game_status;
+		if ( game_status == 0 ) {
+			_winner = Color::OTHER;
+		}
+		if ( game_status == 1 ) {
+			_winner = Color::R;
+		}
+		if ( game_status == 2 ) {
+			_winner = Color::B;
+		}
+		if ( game_status == 3 ) {
+			_winner = Color::NO_ONE;
+		}
+	}
+	void showIntent(PII &m)const noexcept{
+
+		flog << "Player " << this->turn() << " go [" << m.first << ", " << m.second << "]" << std::endl;
+		for(int i=0; i<BOARD_SZ; ++i){
+			for(int j=0; j<BOARD_SZ; ++j){
+				int idx = (i*BOARD_SZ)+j;
+				CUBE cube = this->cube_at(idx);
+				if(cube.c == Color::OTHER){
+					flog << "  ";
+				}else if(cube.c == Color::R){
+					char c = cube.num + 'A';
+					flog << c << ' ';
+				}else{
+					flog << cube.num << ' ';
+				}
+			}
+			flog << std::endl;
+		}
+
+		return;
+	}
+	// return (-100, -100) if not found
+	PII find ( Color who, int num ) const noexcept {
+		int pos = position[enum2int(who)][num];
+		if ( pos == CAPTURED ) {
+			return (std::make_pair(-100, -100));
+		}
+		return (std::make_pair(MOVE_TABLE.row[pos], MOVE_TABLE.col[pos]));
+	}
+	// fills buf with (num, dir), (15, 15) when the player has to pass
+	void generate_moves ( MOVE_BUFFER &buf ) const noexcept { // allow self eating
+		buf.clear();
+		if ( _winner != Color::OTHER ) {
+			return ;
+		}
+		Color color = turn();
+		int ply = enum2int(color);
+		for ( int num=0; num<NUM_CUBE; ++num ) {
+			// 6x6 rule: allow to move any piece
+			// 7x7: move odd/even on odd/even turns
+			if ( TRAITS::PARITY_RULE and (num%2) != (turn_cnt%2) ) {
+				continue;
+			}
+
+			int pos = position[ply][num];
+			if ( pos == CAPTURED ) {
+				continue;
+			}
+
+			for ( int k=0; k<MOVE_TABLE.num_dest[ply][pos]; ++k ) {
+				buf.emplace_back(num, MOVE_TABLE.dest_dir[ply][pos][k]);
+			}
+		}
+		if ( buf.empty() ) {
+			buf.emplace_back(15, 15);
+		}
+	}
+	// vectors of (num, dir)
+	VII move_list () const noexcept {
+		MOVE_BUFFER buf;
+		generate_moves(buf);
+		return (VII(buf.begin(), buf.end()));
+	}
+	bool valid_move ( int const &num, int const &dir ) const noexcept {
+		MOVE_BUFFER buf;
+		generate_moves(buf);
+		return (std::find(buf.begin(), buf.end(), std::make_pair(num, dir)) != buf.end());
+	}
+	// takes back m, the record apply_move() returned for the last move
+	void undo_move ( MOVE const &m ) noexcept {
+		if ( m.pass() ) { // passes this turn
+			prev_turn();
+			return ;
+		}
+
+		int ply = enum2int(m.whose_move());
+		int start_pos = m.start_pos();
+		int end_pos = MOVE_TABLE.to[ply][start_pos][m.dir()];
+		int num = cube_on(ply, end_pos);
+		occupied[ply] ^= bit(start_pos)|bit(end_pos);
+		position[ply][num] = start_pos;
+		key ^= ZOBRIST.cube[ply][num][end_pos]^ZOBRIST.cube[ply][num][start_pos];
+		if ( m.eat_cube() ) {
+			CUBE eaten = m.c();
+			place(enum2int(eaten.c), eaten.num, end_pos);
+			++num_cubes[enum2int(eaten.c)];
+		}
+		// no move is made from a finished game, so it was not over before
+		update_game(0);
+		prev_turn();
+	}
+	// unchecked move for search, (num, dir) must come from generate_moves()
+	// build with -D EINSTEIN_DEBUG to check it against do_move()'s validation
+	// returns what undo_move() needs to take it back
+	MOVE apply_move ( int const &num, int const &dir ) noexcept {
+		Color color = turn();
+		if ( num==15 and dir==15 ) { // no move for current player, pass
+			next_turn();
+			return (MOVE(color));
+		}
+		#ifdef EINSTEIN_DEBUG
+		assert(valid_move(num, dir));
+		#endif
+		
+		int ply = enum2int(color);
+		int now_pos = position[ply][num];
+		int nxt_pos = MOVE_TABLE.to[ply][now_pos][dir];
+		bool eat = (occupied[R_PLAYER]|occupied[B_PLAYER])&bit(nxt_pos);
+		MOVE m(color, now_pos, dir);
+// possible eat
+		if ( eat ) {
+			int eaten_ply = (occupied[R_PLAYER]&bit(nxt_pos))? R_PLAYER: B_PLAYER;
+			int eaten_num = cube_on(eaten_ply, nxt_pos);
+			--num_cubes[eaten_ply];
+			occupied[eaten_ply] ^= bit(nxt_pos);
+			position[eaten_ply][eaten_num] = CAPTURED;
+			key ^= ZOBRIST.cube[eaten_ply][eaten_num][nxt_pos];
+			m = MOVE(color, now_pos, dir, 1, 
+				CUBE(static_cast<Color>(eaten_ply), eaten_num));
+		}
+// movement
+		occupied[ply] ^= bit(now_pos)|bit(nxt_pos);
+		position[ply][num] = nxt_pos;
+		key ^= ZOBRIST.cube[ply][num][now_pos]^ZOBRIST.cube[ply][num][nxt_pos];
+// update game state, only a capture or a corner can end the game
+		if ( eat or nxt_pos == R_CORNER or nxt_pos == B_CORNER ) {
+			update_game(compute_state());
+		}
+		next_turn();
+		#ifdef EINSTEIN_DEBUG
+		assert(key == compute_key());
+		assert(status == compute_state());
+		#endif
+		return (m);
+	}
+	// what evalMove() needs from the position, built once for all its moves
+	struct _eval_masks {
+		BITBOARD below[NUM_PLAYER][NUM_CUBE+1]; // squares of cubes numbered < n
+		int smallest[NUM_PLAYER];
+	};
+	void eval_masks ( _eval_masks &em ) const noexcept {
+		for ( int ply=0; ply<NUM_PLAYER; ++ply ) {
+			em.below[ply][0] = 0;
+			em.smallest[ply] = NUM_CUBE;
+			for ( int num=0; num<NUM_CUBE; ++num ) {
+				em.below[ply][num+1] = em.below[ply][num];
+				if ( position[ply][num] == CAPTURED ) {
+					continue;
+				}
+				em.below[ply][num+1] |= bit(position[ply][num]);
+				if ( em.smallest[ply] == NUM_CUBE ) { em.smallest[ply] = num; }
+			}
+		}
+	}
+	//  3 step next to opponents with more allies
+	//  2 eat a smaller opponent
+	//  1 eat a larger opponent
+	//  0 nothing around
+	// -1 eat an ally, or a corner for any but the smallest cube
+	// -2 step next to a larger opponent
+	// -3 step next to opponents alone, -4 outnumbered, -5 even
+	int evalMove ( PII const &m, _eval_masks const &em ) const noexcept {
+		int const num = m.first;
+		int const dir = m.second;
+		if ( num == 15 or num == 16 ) {
+			return (0);
+		}
+		int ply = _turn;
+		int oppo = !ply;
+		int nxt_pos = MOVE_TABLE.to[ply][position[ply][num]][dir];
+		BITBOARD const nxt = bit(nxt_pos);
+
+		// yummy
+		if ( occupied[ply]&nxt ) {
+			return (-1);
+		}
+		if ( occupied[oppo]&nxt ) {
+			return ((em.below[oppo][num]&nxt)? 2: 1);
+		}
+		if ( (nxt_pos == R_CORNER || nxt_pos == B_CORNER) && num != em.smallest[ply] ) {
+			return (-1);
+		}
+		// neighborhood, the cubes that could step onto nxt_pos next
+		BITBOARD enemy = MOVE_TABLE.from_mask[oppo][nxt_pos]&occupied[oppo];
+		if ( !enemy ) {
+			return (0);
+		}
+		if ( enemy&~em.below[oppo][num+1] ) { // stupid move
+			return (-2);
+		}
+		int totalEnemy = __builtin_popcountll(enemy);
+		int totalAlly = __builtin_popcountll(MOVE_TABLE.from_mask[ply][nxt_pos]&occupied[ply]);
+		if ( totalAlly == 1 ) { // only self
+			return (-3);
+		}
+		else if ( totalAlly > totalEnemy ) {
+			return (3);
+		}
+		else if ( totalAlly < totalEnemy ) {
+			return (-4);
+		}
+		return (-5);
+	}
+	int evalMove ( PII const &m ) const noexcept {
+		_eval_masks em;
+		eval_masks(em);
+		return (evalMove(m, em));
+	}
+	// evalMove() of every move in ml, res[i] for ml[i]
+	void evalMoves ( MOVE_BUFFER const &ml, int *res ) const noexcept {
+		_eval_masks em;
+		eval_masks(em);
+		for ( int i=0; i<ml.size(); ++i ) {
+			res[i] = evalMove(ml[i], em);
+		}
+	}
+	int yummy ( int const &num, int const &dir ) const noexcept {
+// return if this move eats a piece
+// 1 = eat opponent, 0 = no eat, -1 = eat self piece
+		if ( num == 15 or num == 16 ) {
+			return (0);
+		}
+		Color color = turn();
+		int ply = enum2int(color);
+		int nxt_pos = MOVE_TABLE.to[ply][position[ply][num]][dir];
+		if ( occupied[ply]&bit(nxt_pos) ) {
+			return (-1);
+		}
+		else if ( occupied[!ply]&bit(nxt_pos) ) {
+			return (1);
+		} else {
+			return (0);
+		}
+	}
+	int yummy ( PII &p ) const noexcept {
+		return (yummy(p.first, p.second));
+	}
+	MOVE apply_move ( PII const &p ) noexcept {
+		return (apply_move(p.first, p.second));
+	}
+	std::string send_move ( PII &p ) const noexcept {
+		std::string m;
+		m += (char)(p.first+'0');
+		m += (char)(p.second+'0');
+		return (m);
+	}
+};
+using POSITION = _position<BOARD_SZ>;
+static_assert(std::is_trivially_copyable<_position<6>>::value, "search position should stay a flat copy");
+static_assert(std::is_trivially_copyable<_position<7>>::value, "search position should stay a flat copy");
+
+/* Board */
+// a position plus how the game got there, for the game loop and undo
+template<int SZ> struct _board : _position<SZ> {
+	using POSITION = _position<SZ>;
+	using typename POSITION::ULL;
+	using typename POSITION::PII;
+	using typename POSITION::PSS;
+	using typename POSITION::TRAITS;
+	using POSITION::NUM_CUBE;
+	using POSITION::place;
+	using POSITION::valid_move;
+	using POSITION::undo_move;
+	// every move brings a cube closer to its goal corner, at most 2(SZ-1) steps
+	// per cube, and a pass is always answered by a move
+	static constexpr int MAX_GAME_LENGTH = 2*(NUM_PLAYER*NUM_CUBE*2*(SZ-1))+1;
+	using MOVE_STACK = _move_stack<MAX_GAME_LENGTH>;
+
+	ULL seed = 0;
+	int initial[NUM_PLAYER][NUM_CUBE]; // cube on init_cube_pos, for restart
+
+	MOVE_STACK history;
+
+	_board ( ULL const &_seed=std::chrono::system_clock::now().time_since_epoch().count() )  
+noexcept {
+// generate initial cubes
+		seed = _seed;
+		for ( int i=0; i<NUM_PLAYER; ++i ) {
+			std::array<int, NUM_CUBE> init_cube;
+			std::copy(TRAITS::init_cube[i], TRAITS::init_cube[i]+NUM_CUBE, init_cube.begin());
+			#ifdef INIT_RANDOM_SHUFFLE // shuffle initial position
+			std::shuffle(init_cube.begin(), init_cube.end(), 
+				std::default_random_engine(seed+i));
+			#endif
+			for ( int j=0; j<NUM_CUBE; ++j ) {
+				initial[i][j] = init_cube[j];
+				place(i, init_cube[j], TRAITS::init_cube_pos[i][j]);
+			}
+		}
+		history.clear();
+	}
+	_board ( std::string top_left, std::string bottom_right ) noexcept {
+		assert(top_left.size()==NUM_CUBE and bottom_right.size()==NUM_CUBE);
+		std::string str[2]; str[0] = top_left, str[1] = bottom_right;
+		for ( int i=0; i<NUM_PLAYER; ++i ) {
+			for ( int j=0; j<NUM_CUBE; ++j ) {
+				initial[i][j] = str[i][j]-'0';
+				place(i, str[i][j]-'0', TRAITS::init_cube_pos[i][j]);
+			}
+		}
+
+	}
+	// history is cleared, initial/seed are left untouched
+	void unpack ( PACKED const &p ) noexcept {
+		POSITION::unpack(p);
+		history.clear();
+	}
+	PSS give_init_position () {
+		std::string res[2];
+		for ( int i=0; i<2; ++i ) {
+			for ( int j=0; j<NUM_CUBE; ++j ) {
+				res[i] += (char)(initial[i][j]+'0');
+			}
+		}
+		return (make_pair(res[0], res[1]));
+	}
+	void undo_move () noexcept {
+		if ( history.empty() ) {
+			/* brand new board */
+			return ;
+		}
+		MOVE m = history.back(); history.pop_back();
+		undo_move(m);
+	}
+	// checked move for opponent/human input, also takes undo (16, 16)
+	// throws std::runtime_error on an invalid move
+	void do_move ( int const &num, int const &dir ) {
+		if ( num==16 and dir==16 ) { // undo move
+			undo_move(); return ;
+		}
+		if ( !(num==15 and dir==15) and !valid_move(num, dir) ) {
+			flog << "invalid move: " << num << ", " << dir << std::endl;
+			throw std::runtime_error("BOARD::do_move: game is over or the cube/direction is invalid");
+		}
+		apply_move(num, dir);
+	}
+	void apply_move ( int const &num, int const &dir ) noexcept {
+		history.push_back(POSITION::apply_move(num, dir));
+	}
+	void do_move ( PII &p ) {
+		do_move(p.first, p.second);
+	}
+	void apply_move ( PII const &p ) noexcept {
+		apply_move(p.first, p.second);
+	}
+};
+using BOARD = _board<BOARD_SZ>;
+using BOARD6 = _board<6>;
+using BOARD7 = _board<7>;
+template<int SZ> std::ostream &operator << ( std::ostream &os, _board<SZ> const &b ) {
+	auto const &MOVE_TABLE = _board<SZ>::MOVE_TABLE;
+	os << "seed: " << b.seed << "\n";
+	os << "winner: " << b._winner << "\n";
+	for ( int i=0; i<_board<SZ>::NUM_POSITION; ++i ) {
+		CUBE cube = b.cube_at(i);
+		os << "(" << (int)MOVE_TABLE.row[i] << ", " << (int)MOVE_TABLE.col[i] << ", ";
+		if ( cube.c != Color::OTHER ) {
+			os << cube.c << ", " << cube.num << ")";
+		}
+		else {
+			os << "X, X)";
+		}
+		os << " \n"[MOVE_TABLE.col[i]==(SZ-1)];
+	}
+	return (os);
+}
+
+// for display, need cureent position (highlighted and direction)
+template<int SZ> struct _board_gui : _board<SZ> {
+	using BASE = _board<SZ>;
+	using typename BASE::PII;
+	using typename BASE::SQUARE;
+
+	SQUARE hl_pos = SQUARE(0, 0);
+	int dir = 0;
+	bool no_hl = 0;
+	_board_gui () noexcept = default;
+	_board_gui ( std::string a, std::string b) : BASE(a, b) {}
+	_board_gui ( int x, int y, int _dir ) noexcept {
+		hl_pos = SQUARE(x, y);
+		dir = _dir;
+	}
+	void set_hl ( Color c, int num ) {
+		PII pos = this->find(c, num);
+		hl_pos = SQUARE(pos.first, pos.second);
+	}
+	void set_dir ( int _dir ) {
+		dir = _dir;
+	}
+
+	PII getLastMove(){
+		MOVE m = this->history.back();
+		if(m.pass()){
+			return std::make_pair(15, 15);
+		}
+		int ply = enum2int(m.whose_move());
+
+		int num = this->cube_on(ply, BASE::MOVE_TABLE.to[ply][m.start_pos()][m.dir()]);
+
+		return std::make_pair(num, m.dir());
+	}
+};
+using BOARD_GUI = _board_gui<BOARD_SZ>;
+using BOARD_GUI6 = _board_gui<6>;
+using BOARD_GUI7 = _board_gui<7>;
+std::array<std::string, 10> const CUBE_ICON
+{{"０", "１", "２", "３", "４", "５", "６", "７", "８", "９"}};
+template<int SZ> std::ostream &operator << ( std::ostream &os, _board_gui<SZ> const &b_gui ) {
+	using SQUARE = _square<SZ>;
+	auto const &MOVE_TABLE = _board<SZ>::MOVE_TABLE;
+	Color color = b_gui.turn();
+	int who = enum2int(color);
+	os << "\033[m"; // clear scheme
+	os << "\033[1;36mTurn " << b_gui.turn_cnt << "\033[m\n\n";
+	SQUARE hl_dir;
+	if ( b_gui.hl_pos and MOVE_TABLE.to[who][b_gui.hl_pos.pos][b_gui.dir] != -1 ) {
+		hl_dir.pos = MOVE_TABLE.to[who][b_gui.hl_pos.pos][b_gui.dir];
+	}
+	for ( int i=0; i<SZ; ++i ) {
+		for ( int j=0; j<SZ; ++j ) {
+			int pos = i*SZ+j;
+			SQUARE ij = SQUARE(i, j);
+			if ( !b_gui.no_hl and ij == hl_dir ) {
+				if ( color == Color::R ) { os << "\033[1;33;46m＊"; }
+				else { os << "\033[1;32;45m＊"; }
+			}
+			else {
+				CUBE cube = b_gui.cube_at(pos);
+				if ( cube.c != Color::OTHER ) {
+					if ( cube.c == Color::R ) {
+						if ( !b_gui.no_hl and ij == b_gui.hl_pos ) { os << "\033[30;42m"; }
+						else { os << "\033[1;41m"; }
+					}
+					else {
+						if ( !b_gui.no_hl and ij == b_gui.hl_pos ) { os << "\033[30;43m"; }
+						else { os << "\033[1;44m"; }
+					}
+					os << CUBE_ICON[cube.num];
+				}
+				else {
+					os << "\033[47m  ";
+				}
+			}
+			os << "\033[m";
+		}
+		os << "\n";
+	}
+	os << "\033[31mR pieces: " << b_gui.num_cubes[0] << "\033[m\n";
+	os << "\033[34mB pieces: " << b_gui.num_cubes[1] << "\033[m\n";
+	return (os);
+}
+
+/* initial position sent by the judge: red cubes, blue cubes, then 'f'/'s' */
+// 6 digits per side on 6x6 and 10 on 7x7, so one binary can play both
+// returns the board size, 0 if stdin ended
+int read_init_position ( std::string &red, std::string &blue, char &start ) {
+	std::string digits;
+	int ch;
+	while ( (ch = getchar()) >= '0' and ch <= '9' ) {
+		digits.push_back(ch);
+	}
+	if ( ch == EOF ) { return (0); }
+	start = ch;
+	red = digits.substr(0, digits.size()/2);
+	blue = digits.substr(digits.size()/2);
+	if ( digits.size() == 2*_board_traits<7>::NUM_CUBE ) { return (7); }
+	if ( digits.size() == 2*_board_traits<6>::NUM_CUBE ) { return (6); }
+	throw std::runtime_error("read_init_position: unknown board size");
+}
+
+#endif
@@ -271,7 +271,7 @@ struct _agent {
 
 	bool undo_twice = 0;
 	bool my_turn = 0;
-	BOARD_GUI *b;
+	BOARD_GUI b;
 	IO *io = nullptr;
 	int time_limit = 10;
 	_agent () noexcept {
@@ -288,8 +288,7 @@ struct _agent {
 			io->send(p.second);
 			io->send(start);
 		} else {
-			//if ( b != nullptr ) { delete b; }// TODO: destructors in einstein.hpp
-			b = new BOARD_GUI(p.first, p.second);
+			b = BOARD_GUI(p.first, p.second);
 			my_turn = (start=='f');
 		}
 	}
@@ -304,7 +303,7 @@ struct _agent {
 		if ( io != nullptr ) {	
 			io->send(m);
 		} else {
-			b->do_move(m[0]-'0', m[1]-'0');
+			b.do_move(m[0]-'0', m[1]-'0');
 		}
 	}
 // get move of the agent
@@ -312,7 +311,7 @@ struct _agent {
 		if ( io != nullptr ) {
 			return (io->recv(2, time_limit));
 		} else {
-			return (do_human_move(*(b), undo_twice));
+			return (do_human_move(b, undo_twice));
 		}
 	}
 };